@@ -0,0 +1,111 @@
+/**
+ * ----------------------------------------------------------------------------
+ * @file   10-display-list.ino
+ * @author Stéphane Calderoni (https://github.com/m1cr0lab)
+ * @brief  Full-screen 16-bit rendering without any framebuffer.
+ * 
+ * @note   Each frame is described by a display list, which is rasterized
+ *         into 8-row strips streamed to the display one after the other:
+ *         the whole renderer takes about 6 KB of heap instead of the 32 KB
+ *         of a full-screen sprite.
+ * 
+ *         The frame profiler shows in the top left corner the average and
+ *         longest time per call, in microseconds, of the library phases and
+ *         of the "move" zone, and writes them to the serial port every second.
+ * ----------------------------------------------------------------------------
+ */
+
+#include <ESPboy.h>
+
+uint8_t constexpr LOGO_COUNT = 8;
+
+StripRenderer renderer(espboy.tft);
+
+struct Logo {
+
+    int16_t  x, y;
+    int8_t   vx, vy;
+    uint16_t color;
+
+    void spawn() {
+
+        x     = random(TFT_WIDTH  - ESPBOY_LOGO_WIDTH);
+        y     = random(TFT_HEIGHT - ESPBOY_LOGO_HEIGHT);
+        vx    = random(2) ? -1 : 1;
+        vy    = random(2) ? -2 : 2;
+        color = Color::hsv2rgb565(random(360));
+
+    }
+
+    void update() {
+
+        x += vx; if (x < 0 || x + ESPBOY_LOGO_WIDTH  > TFT_WIDTH)  { vx = -vx; x += vx; }
+        y += vy; if (y < 0 || y + ESPBOY_LOGO_HEIGHT > TFT_HEIGHT) { vy = -vy; y += vy; }
+
+    }
+
+    void draw() const {
+
+        renderer.drawBitmap(x, y, ESPBOY_LOGO, ESPBOY_LOGO_WIDTH, ESPBOY_LOGO_HEIGHT, color);
+
+    }
+
+};
+
+Logo    logos[LOGO_COUNT];
+uint8_t move_zone;
+
+void setup() {
+
+    Serial.begin(115200);
+
+    espboy.begin();
+    renderer.begin();
+
+    move_zone = espboy.profiler.zone(F("move"));
+    espboy.profiler.begin(&Serial);
+
+    for (uint8_t i = 0; i < LOGO_COUNT; ++i) logos[i].spawn();
+
+}
+
+void loop() {
+
+    espboy.update();
+
+    {
+        Profiler::Scope scope(move_zone);
+        for (uint8_t i = 0; i < LOGO_COUNT; ++i) logos[i].update();
+    }
+
+    renderer.clear(0x0008);
+    renderer.drawRect(0, 0, TFT_WIDTH, TFT_HEIGHT, 0x4208);
+
+    for (uint8_t i = 0; i < LOGO_COUNT; ++i) logos[i].draw();
+
+    espboy.profiler.draw(renderer, 4, 4);
+
+    renderer.render();
+
+}
+
+/*
+ * ----------------------------------------------------------------------------
+ * ESPboy Library
+ * ----------------------------------------------------------------------------
+ * Copyright (c) 2021-2022 Stéphane Calderoni (https://github.com/m1cr0lab)
+ * 
+ * This program is free software: you can redistribute it and/or modify
+ * it under the terms of the GNU General Public License as published by
+ * the Free Software Foundation, either version 3 of the License, or
+ * (at your option) any later version.
+ * 
+ * This program is distributed in the hope that it will be useful,
+ * but WITHOUT ANY WARRANTY; without even the implied warranty of
+ * MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE. See the
+ * GNU General Public License for more details.
+ * 
+ * You should have received a copy of the GNU General Public License
+ * along with this program. If not, see <https://www.gnu.org/licenses/>.
+ * ----------------------------------------------------------------------------
+ */
\ No newline at end of file
@@ -0,0 +1,95 @@
+/**
+ * ----------------------------------------------------------------------------
+ * @file   11-color-benchmark.ino
+ * @author Stéphane Calderoni (https://github.com/m1cr0lab)
+ * @brief  Compares the computed and table-driven HSV to RGB565 conversions.
+ * 
+ * @note   Color::hsv2rgb565() works out each color with a handful of
+ *         multiplications and divisions, while Color::hsv2rgb565Fast()
+ *         only reads precomputed tables from flash memory. Both are timed
+ *         over the whole hue wheel at every brightness level, and their
+ *         outputs are drawn side by side so that you can compare them.
+ * ----------------------------------------------------------------------------
+ */
+
+#include <ESPboy.h>
+
+uint8_t constexpr PASSES = 4;
+
+uint32_t computed_us;
+uint32_t table_us;
+uint16_t checksum;
+
+uint32_t bench(uint16_t (*convert)(uint16_t, uint8_t)) {
+
+    uint32_t const start = micros();
+
+    for (uint8_t n = 0; n < PASSES; ++n)
+        for (uint16_t hue = 0; hue < 360; ++hue)
+            for (uint16_t val = 0; val < 0x100; val += 0x11)
+                checksum ^= convert(hue, val);
+
+    return micros() - start;
+
+}
+
+uint16_t computed(uint16_t const hue, uint8_t const val) { return Color::hsv2rgb565(hue, 0xff, val); }
+uint16_t table(uint16_t const hue, uint8_t const val)    { return Color::hsv2rgb565Fast(hue, val); }
+
+void drawWheel(uint8_t const y, uint16_t (*convert)(uint16_t, uint8_t)) {
+
+    for (uint8_t x = 0; x < TFT_WIDTH; ++x) {
+        for (uint8_t row = 0; row < 32; ++row) {
+            espboy.tft.drawPixel(x, y + row, convert(x * 360 / TFT_WIDTH, 0xff - (row << 3)));
+        }
+    }
+
+}
+
+void setup() {
+
+    espboy.begin();
+
+    computed_us = bench(computed);
+    table_us    = bench(table);
+
+    char text[24];
+
+    espboy.tft.setTextColor(TFT_WHITE);
+
+    drawWheel(16, computed);
+    snprintf(text, sizeof(text), "computed %6lu us", (unsigned long)computed_us);
+    espboy.tft.drawString(text, 4, 4);
+
+    drawWheel(80, table);
+    snprintf(text, sizeof(text), "table    %6lu us", (unsigned long)table_us);
+    espboy.tft.drawString(text, 4, 68);
+
+}
+
+void loop() {
+
+    espboy.update();
+
+}
+
+/*
+ * ----------------------------------------------------------------------------
+ * ESPboy Library
+ * ----------------------------------------------------------------------------
+ * Copyright (c) 2021-2022 Stéphane Calderoni (https://github.com/m1cr0lab)
+ * 
+ * This program is free software: you can redistribute it and/or modify
+ * it under the terms of the GNU General Public License as published by
+ * the Free Software Foundation, either version 3 of the License, or
+ * (at your option) any later version.
+ * 
+ * This program is distributed in the hope that it will be useful,
+ * but WITHOUT ANY WARRANTY; without even the implied warranty of
+ * MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE. See the
+ * GNU General Public License for more details.
+ * 
+ * You should have received a copy of the GNU General Public License
+ * along with this program. If not, see <https://www.gnu.org/licenses/>.
+ * ----------------------------------------------------------------------------
+ */
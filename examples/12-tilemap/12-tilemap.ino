@@ -0,0 +1,145 @@
+/**
+ * ----------------------------------------------------------------------------
+ * @file   12-tilemap.ino
+ * @author Stéphane Calderoni (https://github.com/m1cr0lab)
+ * @brief  Vertically scrolling tilemap with a sprite.
+ * 
+ * @note   The river is a map of 8x8 tiles flown over by a 16x16 sprite.
+ *         Only the cells that change are drawn: scrolling the map by one
+ *         pixel costs a single row of cells thanks to the scroll registers
+ *         of the display, instead of the 16384 pixels of the whole screen.
+ *         The tiles and the sprite are generated at compile time.
+ * ----------------------------------------------------------------------------
+ */
+
+#include <ESPboy.h>
+
+// ----------------------------------------------------------------------------
+// Tiles
+// ----------------------------------------------------------------------------
+
+enum Tile : uint8_t { WATER, SAND, GRASS, ROCK };
+
+static uint16_t constexpr tilePixel(uint16_t const i) {
+
+    uint8_t const tile = i >> 6;
+    uint8_t const x    = i & 7;
+    uint8_t const y    = i >> 3 & 7;
+
+    uint16_t const color =
+          tile == WATER ? ((x + 2 * y) & 7 ? Color::rgb565(16, 64, 160) : Color::rgb565(64, 128, 208))
+        : tile == SAND  ? ((3 * x + 5 * y) % 7 ? Color::rgb565(208, 184, 120) : Color::rgb565(160, 136, 80))
+        : tile == GRASS ? ((x ^ y) & 3 ? Color::rgb565(40, 136, 48) : Color::rgb565(24, 96, 32))
+        : x == 0 || y == 0 ? Color::rgb565(160, 160, 160)
+        : x == 7 || y == 7 ? Color::rgb565(64, 64, 64)
+        : Color::rgb565(112, 112, 112);
+
+    return hal::displayOrder(color);
+
+}
+
+static uint16_t constexpr shipPixel(uint16_t const i) {
+
+    int8_t const x = i & 15;
+    int8_t const y = i >> 4;
+    int8_t const d = x < 8 ? 7 - x : x - 8; // distance to the axis
+
+    return y < 2 || y > 13 || 2 * d > y - 2 ? 0xf81f // transparent
+         : d == 0 && y < 8                  ? hal::displayOrder(Color::rgb565(255, 64, 0))
+         : hal::displayOrder(Color::rgb565(224, 224, 224));
+
+}
+
+auto constexpr TILES PROGMEM = Color::palette<4 * 8 * 8>(tilePixel);
+auto constexpr SHIP  PROGMEM = Color::palette<16 * 16>(shipPixel);
+
+// ----------------------------------------------------------------------------
+// Map
+// ----------------------------------------------------------------------------
+
+static uint8_t  constexpr COLS = 16;
+static uint8_t  constexpr ROWS = 64;
+static uint16_t constexpr BOTTOM = ROWS * 8 - TFT_HEIGHT;
+
+uint8_t tiles[COLS * ROWS];
+
+TileMap river(espboy.tft);
+int8_t  ship;
+int16_t ship_x = 56, ship_y = 96; // on the screen
+int16_t view_y = BOTTOM;
+
+void generate() {
+
+    int8_t center = COLS >> 1;
+    int8_t width  = 4;
+
+    for (uint8_t row = 0; row < ROWS; ++row) {
+
+        center += random(3) - 1; if (center < 4) center = 4; else if (center > COLS - 4) center = COLS - 4;
+        width  += random(3) - 1; if (width  < 2) width  = 2; else if (width  > 6)        width  = 6;
+
+        for (uint8_t col = 0; col < COLS; ++col) {
+            int8_t const d = abs(col - center);
+            tiles[row * COLS + col] = d < width >> 1      ? WATER
+                                    : d < (width >> 1) + 1 ? SAND
+                                    : random(8)            ? GRASS
+                                    : ROCK;
+        }
+
+    }
+
+}
+
+// ----------------------------------------------------------------------------
+// Main program
+// ----------------------------------------------------------------------------
+
+void setup() {
+
+    espboy.begin();
+
+    generate();
+    river.begin(TileSheet(TILES.colors, 8), tiles, COLS, ROWS);
+    river.scrollTo(0, view_y);
+    ship = river.addSprite(TileSheet(SHIP.colors, 16), 0, ship_x, view_y + ship_y, 1);
+
+}
+
+void loop() {
+
+    espboy.update();
+
+    if (espboy.button.held(Button::LEFT)  && ship_x > 0)                ship_x--;
+    if (espboy.button.held(Button::RIGHT) && ship_x < TFT_WIDTH - 16)   ship_x++;
+    if (espboy.button.held(Button::UP)    && ship_y > 0)                ship_y--;
+    if (espboy.button.held(Button::DOWN)  && ship_y < TFT_HEIGHT - 16)  ship_y++;
+
+    // back to the bottom of the river once its source is reached
+    view_y = view_y ? view_y - 1 : BOTTOM;
+
+    river.scrollTo(0, view_y);
+    river.moveSprite(ship, ship_x, view_y + ship_y);
+    river.render();
+
+}
+
+/*
+ * ----------------------------------------------------------------------------
+ * ESPboy Library
+ * ----------------------------------------------------------------------------
+ * Copyright (c) 2021-2022 Stéphane Calderoni (https://github.com/m1cr0lab)
+ * 
+ * This program is free software: you can redistribute it and/or modify
+ * it under the terms of the GNU General Public License as published by
+ * the Free Software Foundation, either version 3 of the License, or
+ * (at your option) any later version.
+ * 
+ * This program is distributed in the hope that it will be useful,
+ * but WITHOUT ANY WARRANTY; without even the implied warranty of
+ * MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE. See the
+ * GNU General Public License for more details.
+ * 
+ * You should have received a copy of the GNU General Public License
+ * along with this program. If not, see <https://www.gnu.org/licenses/>.
+ * ----------------------------------------------------------------------------
+ */
\ No newline at end of file
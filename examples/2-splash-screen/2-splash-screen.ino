@@ -31,6 +31,29 @@
  *               - colormap: an array of 16-bit integers defining the logo colormap in RGB565 space.
  *               - wait:     the time length in milliseconds during which the logo must remain displayed (1000 ms by default).
  * 
+ *           - compressed logo (asset), converted from a PNG file with extras/tools/png2asset.py:
+ * 
+ *               espboy.begin(Asset(asset), color, wait)
+ * 
+ *             where:
+ *               - asset: an array of 8-bit integers holding the compressed logo (the colormap
+ *                        of this example shrinks from 2660 to 364 bytes).
+ *               - color: the logo display color in 16-bit (RGB565) format, for a monochromatic logo only (0xffff by default).
+ *               - wait:  the time length in milliseconds during which the logo must remain displayed (1000 ms by default).
+ * 
+ *         To shorten the boot sequence, call before espboy.begin():
+ * 
+ *           espboy.setBootPolicy(policy, splash_on_wake)
+ * 
+ *             where:
+ *               - policy:         BootPolicy::SPLASH to wait for the end of the splash screen (default),
+ *                                 BootPolicy::ASYNC_SPLASH to play the splash screen in the background
+ *                                 (espboy.splashing() tells when it is over, don't draw before),
+ *                                 or BootPolicy::NO_SPLASH to skip it altogether.
+ *               - splash_on_wake: whether the splash screen is played when waking up from deep sleep (true by default).
+ * 
+ *         The measured duration of each boot phase is given by espboy.bootTimeline().
+ * 
  * @details Note that for color settings you can use the Color toolbox:
  * 
  *            Color::rgb565(red, green, blue)
@@ -139,11 +162,43 @@ static uint16_t const constexpr COLORMAP[] PROGMEM = {
 
 };
 
+static uint8_t const constexpr LOGO_ASSET[] PROGMEM = {
+
+    // size: 35x38, 4 bpp, 5 colors, RLE
+    // 364 bytes (14% of the uncompressed colormap)
+
+    0x64, 0x23, 0x26, 0x04, 0x00, 0x00, 0x00, 0x40, 0xfc, 0xff, 0xff, 0x55, 0xad, 0xc0, 0xfd, 0x8d,
+    0x00, 0x82, 0x01, 0x9c, 0x00, 0x84, 0x01, 0x95, 0x00, 0x01, 0x11, 0x82, 0x00, 0x84, 0x01, 0x82,
+    0x00, 0x01, 0x11, 0x8e, 0x00, 0x82, 0x01, 0x81, 0x00, 0x84, 0x01, 0x81, 0x00, 0x82, 0x01, 0x8d,
+    0x00, 0x82, 0x01, 0x82, 0x00, 0x82, 0x04, 0x82, 0x00, 0x82, 0x01, 0x8e, 0x00, 0x01, 0x44, 0x8c,
+    0x00, 0x01, 0x44, 0x92, 0x00, 0x01, 0x11, 0x81, 0x00, 0x01, 0x11, 0x81, 0x00, 0x01, 0x11, 0x94,
+    0x00, 0x82, 0x01, 0x00, 0x00, 0x82, 0x01, 0x00, 0x00, 0x82, 0x01, 0x93, 0x00, 0x82, 0x01, 0x00,
+    0x00, 0x82, 0x01, 0x00, 0x00, 0x82, 0x01, 0x94, 0x00, 0x01, 0x44, 0x81, 0x00, 0x01, 0x44, 0x81,
+    0x00, 0x01, 0x44, 0xbd, 0x00, 0x01, 0x11, 0x9e, 0x00, 0x82, 0x01, 0x9d, 0x00, 0x82, 0x01, 0x9e,
+    0x00, 0x01, 0x44, 0x9c, 0x00, 0x01, 0x11, 0x82, 0x00, 0x01, 0x11, 0x98, 0x00, 0x82, 0x01, 0x01,
+    0x00, 0x82, 0x01, 0x97, 0x00, 0x82, 0x01, 0x01, 0x00, 0x82, 0x01, 0x98, 0x00, 0x01, 0x44, 0x82,
+    0x00, 0x01, 0x44, 0xba, 0x00, 0x01, 0x11, 0x86, 0x00, 0x01, 0x11, 0x94, 0x00, 0x82, 0x01, 0x84,
+    0x00, 0x82, 0x01, 0x93, 0x00, 0x82, 0x01, 0x84, 0x00, 0x82, 0x01, 0x94, 0x00, 0x01, 0x44, 0x86,
+    0x00, 0x01, 0x44, 0xd0, 0x00, 0xa1, 0x03, 0xc4, 0x00, 0x83, 0x02, 0x01, 0x00, 0x81, 0x02, 0x01,
+    0x00, 0x82, 0x02, 0x02, 0x00, 0x20, 0x8e, 0x00, 0x00, 0x20, 0x83, 0x00, 0x00, 0x20, 0x81, 0x00,
+    0x02, 0x20, 0x20, 0x81, 0x00, 0x02, 0x20, 0x20, 0x8e, 0x00, 0x00, 0x20, 0x83, 0x00, 0x00, 0x20,
+    0x83, 0x00, 0x00, 0x20, 0x81, 0x00, 0x05, 0x20, 0x20, 0x22, 0x81, 0x00, 0x81, 0x02, 0x02, 0x00,
+    0x20, 0x81, 0x00, 0x83, 0x02, 0x81, 0x00, 0x81, 0x02, 0x01, 0x00, 0x82, 0x02, 0x08, 0x00, 0x22,
+    0x00, 0x20, 0x20, 0x81, 0x00, 0x02, 0x20, 0x20, 0x81, 0x00, 0x01, 0x22, 0x87, 0x00, 0x02, 0x20,
+    0x20, 0x83, 0x00, 0x00, 0x20, 0x81, 0x00, 0x02, 0x20, 0x20, 0x81, 0x00, 0x02, 0x20, 0x20, 0x81,
+    0x00, 0x01, 0x22, 0x83, 0x00, 0x00, 0x20, 0x81, 0x00, 0x02, 0x20, 0x20, 0x83, 0x00, 0x06, 0x22,
+    0x00, 0x20, 0x20, 0x81, 0x00, 0x02, 0x20, 0x00, 0x87, 0x02, 0x01, 0x00, 0x81, 0x02, 0x02, 0x00,
+    0x20, 0x83, 0x00, 0x03, 0x20, 0x22, 0x81, 0x00, 0x81, 0x02, 0x84, 0x00, 0x00, 0x20, 0x9c, 0x00,
+    0x00, 0x20, 0x81, 0x00, 0x00, 0x20, 0x9d, 0x00, 0x81, 0x02, 0x00, 0x00
+
+};
+
 void setup() {
 
     // Choose from:
     // espboy.begin(28, 34, BITMAP, 0xffff, 2000);
     // espboy.begin(35, 38, COLORMAP, 2000);
+    // espboy.begin(Asset(LOGO_ASSET), 0xffff, 2000);
 
     espboy.begin(28, 34, BITMAP);
 
@@ -34,6 +34,11 @@
  *         To find out if a button has just been released:
  * 
  *           if (espboy.button.released(Button::ACT)) { ... }
+ * 
+ *         To get all the buttons that have just been pressed (or released)
+ *         at once, as a bitmask to be tested against the PAD_* constants:
+ * 
+ *           if (espboy.button.pressedMask() & (PAD_LEFT | PAD_RIGHT)) { ... }
  * ----------------------------------------------------------------------------
  */
 
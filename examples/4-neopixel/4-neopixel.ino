@@ -62,7 +62,38 @@
  *                         but you can set 0 if you want the effect to last
  *                         indefinitely).
  * 
- *         To cancel any light effect (flash, breathe, or rainbow) and turn the LED off:
+ *         --------------------
+ *         Keyframe animations
+ *         --------------------
+ * 
+ *         The effects above are built on a keyframe animation engine that
+ *         you can feed with your own tracks, stored in flash memory:
+ * 
+ *           LedKey constexpr HEARTBEAT[] PROGMEM = {
+ *               { color, duration, easing },
+ *               ...
+ *           };
+ * 
+ *             where:
+ *               - color:    the RGB888 color reached at the end of the key.
+ *               - duration: the length in milliseconds of the transition
+ *                           from the previous color.
+ *               - easing:   the shape of the transition (Easing::STEP,
+ *                           LINEAR, EASE_IN, EASE_OUT or EASE_IN_OUT).
+ * 
+ *           espboy.pixel.play(LedTrack(HEARTBEAT, count), tint)
+ *           espboy.pixel.queue(LedTrack(HEARTBEAT, count), tint)
+ * 
+ *             where:
+ *               - count: the number of times the track is played (1 by default,
+ *                        0 to play it indefinitely).
+ *               - tint:  a RGB888 color by which the colors of the keys are
+ *                        multiplied (white by default).
+ * 
+ *             play() starts the track right away, queue() starts it once the
+ *             tracks already queued are over.
+ * 
+ *         To cancel any light effect (flash, breathe, rainbow or track) and turn the LED off:
  * 
  *           espboy.pixel.reset();
  * 
@@ -88,6 +119,16 @@
 
 #include <ESPboy.h>
 
+LedKey constexpr HEARTBEAT[] PROGMEM = {
+
+    { 0xffffff,  80, Easing::EASE_OUT },
+    { 0x404040, 120, Easing::EASE_IN  },
+    { 0xffffff,  80, Easing::EASE_OUT },
+    { 0x000000, 400, Easing::EASE_IN  },
+    { 0x000000, 320, Easing::STEP     }
+
+};
+
 uint8_t brightness;
 
 void setup() {
@@ -104,6 +145,7 @@ void setup() {
     espboy.tft.drawString(F("DOWN  Rainbow"),       8, y += 12);
     espboy.tft.drawString(F("ACT   + Brightness"),  8, y += 12);
     espboy.tft.drawString(F("ESC   - Brightness"),  8, y += 12);
+    espboy.tft.drawString(F("LFT   Heartbeat"),     8, y += 12);
 
     espboy.pixel.setBrightness(brightness = 0x40);
 
@@ -122,10 +164,11 @@ void loop() {
         uint32_t color  = Color::hsv2rgb(hue);
         uint16_t period = 1 << random(8, 12);
 
-             if (espboy.button.pressed(Button::LEFT))  espboy.pixel.flash(color, 100, 0, 1000);
-        else if (espboy.button.pressed(Button::RIGHT)) espboy.pixel.flash(color,  50, 0,  250);
-        else if (espboy.button.pressed(Button::UP))    espboy.pixel.breathe(color, period, 0);
-        else if (espboy.button.pressed(Button::DOWN))  espboy.pixel.rainbow(period, 0);
+             if (espboy.button.pressed(Button::LEFT))     espboy.pixel.flash(color, 100, 0, 1000);
+        else if (espboy.button.pressed(Button::RIGHT))    espboy.pixel.flash(color,  50, 0,  250);
+        else if (espboy.button.pressed(Button::UP))       espboy.pixel.breathe(color, period, 0);
+        else if (espboy.button.pressed(Button::DOWN))     espboy.pixel.rainbow(period, 0);
+        else if (espboy.button.pressed(Button::TOP_LEFT)) espboy.pixel.play(LedTrack(HEARTBEAT, 0), color);
         else {
 
             static uint32_t last = millis();
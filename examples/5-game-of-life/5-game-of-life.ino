@@ -3,56 +3,31 @@
  * @file   5-game-of-life.ino
  * @author Stéphane Calderoni (https://github.com/m1cr0lab)
  * @brief  A cellular automaton designed by John Horton Conway (1970).
+ * 
+ * @note   The universe is computed by the Life engine of the library, which
+ *         packs 32 cells per word and updates them 32 at a time, and it is
+ *         blitted as is into a 1-bit palettized framebuffer: both take 8 KB
+ *         of heap altogether.
  * ----------------------------------------------------------------------------
  */
 
 #include <ESPboy.h>
 
-LGFX_Sprite framebuffer(&espboy.tft);
-
-uint8_t ng[TFT_WIDTH+2][TFT_HEIGHT+2];
-uint8_t pg[TFT_WIDTH+2][TFT_HEIGHT+2];
+PaletteBuffer framebuffer(espboy.tft);
+Life          life(TFT_WIDTH, TFT_HEIGHT);
 
 void reset() {
 
     espboy.pixel.breathe(Color::hsv2rgb(120), 250, 2);
-
-    for (uint8_t y = 1; y <= TFT_HEIGHT; ++y) {
-        for (uint8_t x = 1; x <= TFT_WIDTH; ++x) {
-            ng[x][y] = !random(5);
-        }
-    }
-
-}
-
-void update() {
-
-    memcpy(pg, ng, sizeof(ng));
-
-    for (uint8_t y = 1; y <= TFT_HEIGHT; ++y) {
-        for (uint8_t x = 1; x <= TFT_WIDTH; ++x) {
-            
-            uint8_t const n = pg[x-1][y-1] + pg[x][y-1] + pg[x+1][y-1] +
-                              pg[x-1][ y ]              + pg[x+1][ y ] +
-                              pg[x-1][y+1] + pg[x][y+1] + pg[x+1][y+1];
-
-            ng[x][y] = pg[x][y] ? n == 2 || n == 3 : n == 3;
-        }
-    }
+    life.randomize(5);
 
 }
 
 void draw() {
 
-    framebuffer.clear();
-
-    for (uint8_t y = 1; y <= TFT_HEIGHT; ++y) {
-        for (uint8_t x = 1; x <= TFT_WIDTH; ++x) {
-            if (ng[x][y]) framebuffer.drawPixel(x-1, y-1, 0x1);
-        }
-    }
-
-    framebuffer.pushSprite(0, 0);
+    framebuffer.wait();
+    life.blit(framebuffer.sprite());
+    framebuffer.flush();
 
 }
 
@@ -60,10 +35,12 @@ void setup() {
 
     espboy.begin();
 
-    framebuffer.setColorDepth(lgfx::palette_1bit);
-    framebuffer.createSprite(TFT_WIDTH, TFT_HEIGHT);
-    framebuffer.createPalette();
-    framebuffer.setPaletteColor(1, 0x00, 0xff, 0x80);
+    framebuffer.begin(1);
+    framebuffer.setColor(1, Color::rgb565(0x00, 0xff, 0x80));
+
+    life.begin();
+
+    espboy.button.enableEvents();
 
     reset();
     draw();
@@ -74,9 +51,13 @@ void loop() {
 
     espboy.update();
 
-    if (espboy.button.pressed(Button::ACT)) reset();
+    ButtonEvent event;
+
+    while (espboy.button.nextEvent(event)) {
+        if (event.button == Button::ACT && event.pressed) reset();
+    }
 
-    update();
+    life.step();
     draw();
 
 }
@@ -3,112 +3,98 @@
  * @file   6-fireworks.ino
  * @author Stéphane Calderoni (https://github.com/m1cr0lab)
  * @brief  A nice example to see how to implement a particle generator.
+ * 
+ * @note   The simulation runs at a fixed timestep, so that the fireworks
+ *         keep the same pace whatever the time spent drawing them.
+ *         The sparkles are handled by the fixed-point particle system of
+ *         the library, and frames are drawn in two bands, each one being
+ *         sent to the display in the background while the next one is drawn.
  * ----------------------------------------------------------------------------
  */
 
 #include <ESPboy.h>
 
-uint8_t constexpr MAX_FIREWORKS = 5;
-uint8_t constexpr MAX_SPARKLES  = 40;
-float_t constexpr GRAVITY       = .25f;
+uint8_t constexpr MAX_ROCKETS  = 5;
+uint8_t constexpr MAX_SPARKLES = 40;
+uint8_t constexpr BAND_HEIGHT  = 16; // rows drawn at once without the double buffer
+int16_t constexpr GRAVITY      = Particles::q8(.25f);
 
-LGFX_Sprite fb(&espboy.tft);
+Particles   particles;
+Random      rng;
+LGFX_Sprite band(&espboy.tft); // used when the double buffer doesn't fit in the heap
+bool        double_buffered;
 
-struct Sparkle {
+struct Rocket {
 
     bool     fired;
-    bool     first;
-    float_t  x;
-    float_t  y;
-    float_t  vx;
-    float_t  vy;
+    int32_t  x, y;   // Q16.16
+    int16_t  vx, vy; // Q8.8
     uint16_t hue;
-    uint8_t  lifespan;
+    uint16_t color;
 
-    void fire(uint8_t const x, uint8_t const y, uint16_t const hue, bool const first = false) {
+    void fire() {
 
-        fired       = true;
-        this->first = first;
-        this->x     = x;
-        this->y     = y;
-        vx          = (random(2) ? -1 : 1) * (random(first ? 20 : 30) / 10.f);
-        vy          = first ? -4 - (random(30) / 10.f) : -1 - (random(40) / 10.f);
-        this->hue   = hue;
-        lifespan    = 0xff;
+        fired = true;
+        x     = (int32_t)(TFT_WIDTH >> 1) << 16;
+        y     = (int32_t)(TFT_HEIGHT - 1) << 16;
+        vx    = rng.range(Particles::q8(-2), Particles::q8(2));
+        vy    = rng.range(Particles::q8(-7), Particles::q8(-4));
+        hue   = rng.below(360);
+        color = Color::hsv2rgb565(hue);
 
     }
 
-    void update() {
-
-        x += vx;
-        y += vy;
-
-        if (x < 0 || x + 1 > TFT_WIDTH || y + 1 > TFT_HEIGHT) {
-            fired = false;
-            return;
-        }
+    void explode() {
 
-        vy += GRAVITY;
-
-        lifespan > 3
-            ? lifespan -= 3
-            : fired = false;
-
-    }
+        fired = false;
+        espboy.pixel.flash(Color::hsv2rgb(hue), 50);
 
-    void draw() {
+        uint8_t const emitter = particles.createEmitter(hue, 2, GRAVITY, 3);
+        if (emitter == Particles::NO_EMITTER) return;
 
-        first
-            ? fb.fillRect(x - 1, y - 1, 3, 3, Color::hsv2rgb565(hue))
-            : fb.fillRect(x,     y,     2, 2, Color::hsv2rgb565(hue, 0xff, lifespan));
+        particles.burst(emitter, x >> 16, y >> 16, MAX_SPARKLES, rng, Particles::q8(3), Particles::q8(-5), Particles::q8(-1));
 
     }
 
-};
-
-struct Firework {
-
-    uint16_t hue;
-    Sparkle  sparkles[MAX_SPARKLES];
-
-    void fire() { sparkles[0].fire(TFT_WIDTH >> 1, TFT_HEIGHT - 1, (hue = random(360)), true); }
-
     void update() {
 
-        for (uint8_t i = 0; i < MAX_SPARKLES; ++i) {
-
-            Sparkle * const s = &sparkles[i];
-
-            if (s->fired) s->update();
-            if (s->first && s->vy > 0) {
-                espboy.pixel.flash(Color::hsv2rgb(hue), 50);
-                for (uint8_t j = 0; j < MAX_SPARKLES; ++j) {
-                    sparkles[j].fire(s->x, s->y, s->hue);
-                }
-            }
+        x  += (int32_t)vx << 8;
+        y  += (int32_t)vy << 8;
+        vy += GRAVITY;
 
-        }
+        if (x < 0 || x >> 16 >= TFT_WIDTH) fired = false;
+        else if (vy > 0) explode();
 
     }
 
-    void draw() {
+    void draw(hal::Sprite &fb, int16_t const band_y) const {
 
-        for (uint8_t i = 0; i < MAX_SPARKLES; ++i) {
-            Sparkle * const s = &sparkles[i];
-            if (s->fired) s->draw();
-        }
+        fb.fillRect((x >> 16) - 1, (y >> 16) - 1 - band_y, 3, 3, color);
 
     }
 
 };
 
-Firework fireworks[MAX_FIREWORKS];
-uint8_t firework_index = 0;
+Rocket rockets[MAX_ROCKETS];
+uint8_t rocket_index = 0;
 
 void setup() {
 
     espboy.begin();
-    fb.createSprite(TFT_WIDTH, TFT_HEIGHT);
+    espboy.pacer.setFrameRate(50);
+    espboy.pacer.setTickRate(50);
+
+    double_buffered = espboy.enableDoubleBuffer();
+
+    if (!double_buffered && !band.createSprite(TFT_WIDTH, BAND_HEIGHT)) {
+        espboy.tft.drawString(F("Out of memory"), 0, 0);
+        for (;;) delay(1000);
+    }
+
+    particles.begin(MAX_ROCKETS * MAX_SPARKLES, MAX_ROCKETS);
+
+    // drawn from random(), so that a recorded session replays the same show
+    rng.seed(random(0x7fffffff));
 
 }
 
@@ -116,24 +102,36 @@ void loop() {
 
     espboy.update();
 
-    if (random(30) == 0) {
+    for (uint8_t n = espboy.pacer.ticks(); n; --n) {
 
-        fireworks[firework_index++].fire();
-        if (firework_index == MAX_FIREWORKS) firework_index = 0;
+        if (rng.below(30) == 0) {
 
-    }
+            Rocket * const r = &rockets[rocket_index++];
+            if (!r->fired) r->fire();
+            if (rocket_index == MAX_ROCKETS) rocket_index = 0;
 
-    fb.clear();
+        }
 
-    for (uint8_t i = 0; i < MAX_FIREWORKS; ++i) {
+        for (uint8_t i = 0; i < MAX_ROCKETS; ++i) if (rockets[i].fired) rockets[i].update();
 
-        Firework * const f = &fireworks[i];
-        f->update();
-        f->draw();
+        particles.update();
 
     }
 
-    fb.pushSprite(0, 0);
+    uint8_t const height = double_buffered ? espboy.screen.height() : BAND_HEIGHT;
+
+    for (int16_t band_y = 0; band_y < TFT_HEIGHT; band_y += height) {
+
+        hal::Sprite &fb = double_buffered ? espboy.screen.canvas() : band;
+        fb.clear();
+
+        particles.draw(fb, band_y);
+        for (uint8_t i = 0; i < MAX_ROCKETS; ++i) if (rockets[i].fired) rockets[i].draw(fb, band_y);
+
+        if (double_buffered) espboy.screen.present(band_y);
+        else                 band.pushSprite(0, band_y);
+
+    }
 
 }
 
@@ -18,6 +18,10 @@ static uint8_t constexpr ROWS = (TFT_HEIGHT - 4) / SIZE;
 static uint8_t constexpr OX   = (TFT_WIDTH  - COLS * SIZE) >> 1;
 static uint8_t constexpr OY   = (TFT_HEIGHT - ROWS * SIZE) >> 1;
 
+static uint16_t constexpr FRAME_COLOR = Color::rgb565(128, 128, 128);
+static uint16_t constexpr DEATH_COLOR = Color::rgb565(255, 255, 255);
+static uint16_t constexpr SCORE_COLOR = Color::rgb565(255, 255,   0);
+
 // ----------------------------------------------------------------------------
 // Point
 // ----------------------------------------------------------------------------
@@ -40,7 +44,9 @@ struct Point {
 
 struct Apple : Point {
 
-    void draw() const { Point::draw(0xfd40); }
+    static uint16_t constexpr COLOR = Color::rgb565(255, 168, 0);
+
+    void draw() const { Point::draw(COLOR); }
 
 };
 
@@ -54,7 +60,7 @@ struct Snake {
 
     static uint8_t  constexpr START_LENGTH = 3;
     static uint16_t constexpr MAX_LENGTH   = COLS * ROWS;
-    static uint16_t constexpr COLOR        = 0x07ea;
+    static uint16_t constexpr COLOR        = Color::rgb565(0, 252, 80);
 
     enum class Dir : uint8_t { UP, RIGHT, DOWN, LEFT };
 
@@ -154,12 +160,12 @@ void Snake::update() {
 
     if (n->x + 1 > COLS || n->y + 1 > ROWS) {
         head = h;
-        p->draw(0xffff);
+        p->draw(DEATH_COLOR);
         die();
     }
 
     if (overlap(n)) {
-        n->draw(0xffff);
+        n->draw(DEATH_COLOR);
         die();
     }
 
@@ -208,7 +214,7 @@ void reset() {
 
 void waitForRestart() {
 
-    displayScore(0xffe0);
+    displayScore(SCORE_COLOR);
 
     if (espboy.button.pressed(Button::ACT)) {
         espboy.tft.fillRect(OX - 1, OY - 1, COLS * SIZE + 2, ROWS * SIZE + 2, 0);
@@ -227,7 +233,7 @@ void update() {
         espboy.pixel.breathe(Color::hsv2rgb(30), 300);
     }
 
-    displayScore(0x8410);
+    displayScore(FRAME_COLOR);
     apple.draw();
     snake.draw();
 
@@ -241,9 +247,11 @@ void setup() {
 
     espboy.begin();
     espboy.tft.setTextDatum(top_right);
-    espboy.tft.drawRect(OX - 2, OY - 2, COLS * SIZE + 4, ROWS * SIZE + 4, 0x8410);
+    espboy.tft.drawRect(OX - 2, OY - 2, COLS * SIZE + 4, ROWS * SIZE + 4, FRAME_COLOR);
     reset();
 
+    espboy.scheduler.every(60, update);
+
 }
 
 void loop() {
@@ -257,11 +265,6 @@ void loop() {
     else if (espboy.button.pressed(Button::RIGHT)) snake.right();
     else if (espboy.button.pressed(Button::DOWN))  snake.down();
 
-    static uint32_t last = millis();
-    uint32_t const now   = millis();
-
-    if (now - last > 60) { update(); last = now; }
-
 }
 
 /*
@@ -8,7 +8,7 @@
 
 #include <ESPboy.h>
 
-LGFX_Sprite framebuffer(&espboy.tft);
+FrameBuffer framebuffer(espboy.tft);
 
 struct Space {
 
@@ -220,7 +220,7 @@ Spaceship ship;
 void setup() {
 
     espboy.begin();
-    framebuffer.createSprite(TFT_WIDTH, TFT_HEIGHT);
+    framebuffer.begin();
 
 }
 
@@ -241,7 +241,7 @@ void loop() {
     framebuffer.clear();
     space.draw();
     ship.draw();
-    framebuffer.pushSprite(0, 0);
+    framebuffer.flush();
 
 }
 
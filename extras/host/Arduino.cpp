@@ -0,0 +1,81 @@
+/**
+ * ----------------------------------------------------------------------------
+ * @file   Arduino.cpp
+ * @author Stéphane Calderoni (https://github.com/m1cr0lab)
+ * @brief  Minimal Arduino core stand-in for host builds
+ * ----------------------------------------------------------------------------
+ */
+
+#include <Arduino.h>
+#include <HAL.h>
+#include <time.h>
+
+uint32_t millis() { return hal::Clock::ms(); }
+uint32_t micros() { return hal::Clock::us(); }
+
+void delay(uint32_t const ms) { delayMicroseconds(ms * 1000); }
+
+void delayMicroseconds(uint32_t const us) {
+
+    uint32_t const start = micros();
+
+    // in virtual time, waiting is just moving the clock forward
+    hal::Clock::advance(us);
+
+    while (micros() - start < us) {
+        timespec const ts = { 0, 50000 };
+        nanosleep(&ts, nullptr);
+    }
+
+}
+
+void yield() {}
+
+void pinMode(uint8_t const, uint8_t const) {}
+void digitalWrite(uint8_t const, uint8_t const) {}
+int  digitalRead(uint8_t const) { return HIGH; }
+
+/**
+ * @note xorshift32, so that host runs are reproducible across platforms.
+ */
+static uint32_t _random_state = 0x2545f491;
+
+static uint32_t _random() {
+
+    uint32_t x = _random_state;
+    x ^= x << 13;
+    x ^= x >> 17;
+    x ^= x << 5;
+
+    return _random_state = x;
+
+}
+
+long random(long const max) { return max > 0 ? _random() % max : 0; }
+
+long random(long const min, long const max) { return min < max ? min + random(max - min) : min; }
+
+void randomSeed(unsigned long const seed) { if (seed) _random_state = seed; }
+
+HostSerial Serial;
+
+/*
+ * ----------------------------------------------------------------------------
+ * ESPboy Library
+ * ----------------------------------------------------------------------------
+ * Copyright (c) 2021-2022 Stéphane Calderoni (https://github.com/m1cr0lab)
+ * 
+ * This program is free software: you can redistribute it and/or modify
+ * it under the terms of the GNU General Public License as published by
+ * the Free Software Foundation, either version 3 of the License, or
+ * (at your option) any later version.
+ * 
+ * This program is distributed in the hope that it will be useful,
+ * but WITHOUT ANY WARRANTY; without even the implied warranty of
+ * MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE. See the
+ * GNU General Public License for more details.
+ * 
+ * You should have received a copy of the GNU General Public License
+ * along with this program. If not, see <https://www.gnu.org/licenses/>.
+ * ----------------------------------------------------------------------------
+ */
\ No newline at end of file
@@ -0,0 +1,127 @@
+/**
+ * ----------------------------------------------------------------------------
+ * @file   Arduino.h
+ * @author Stéphane Calderoni (https://github.com/m1cr0lab)
+ * @brief  Minimal Arduino core stand-in for host builds
+ * 
+ * @details Provides just what the ESPboy library relies on, so that it can
+ *          be compiled on a Linux dev box against the hal:: stand-ins.
+ * ----------------------------------------------------------------------------
+ */
+
+#pragma once
+
+#include <stdint.h>
+#include <stddef.h>
+#include <stdio.h>
+#include <stdlib.h>
+#include <string.h>
+#include <math.h>
+
+typedef uint8_t  byte;
+typedef uint16_t uint16;
+typedef uint32_t uint32;
+
+#define ESPBOY_HOST
+
+#define F_CPU 80000000L
+
+#define LOW          0x0
+#define HIGH         0x1
+#define INPUT        0x0
+#define OUTPUT       0x1
+#define INPUT_PULLUP 0x2
+
+#define CHANGE  1
+#define FALLING 2
+#define RISING  3
+
+uint8_t constexpr D4 = 2;
+
+// Flash memory is plain memory on the host
+
+#define PROGMEM
+#define IRAM_ATTR
+#define ICACHE_RAM_ATTR
+#define PGM_P const char *
+
+#define pgm_read_byte(addr)  (*(uint8_t  const *)(addr))
+#define pgm_read_word(addr)  (*(uint16_t const *)(addr))
+#define pgm_read_dword(addr) (*(uint32_t const *)(addr))
+#define pgm_read_ptr(addr)   (*(void * const *)(addr))
+
+#define strlen_P  strlen
+#define strncpy_P strncpy
+#define memcpy_P  memcpy
+
+class __FlashStringHelper;
+#define FPSTR(p) (reinterpret_cast<__FlashStringHelper const *>(p))
+#define F(s)     FPSTR(s)
+
+// Time, I/O and random numbers
+
+uint32_t millis();
+uint32_t micros();
+void     delay(uint32_t const ms);
+void     delayMicroseconds(uint32_t const us);
+void     yield();
+
+void    pinMode(uint8_t const pin, uint8_t const mode);
+void    digitalWrite(uint8_t const pin, uint8_t const value);
+int     digitalRead(uint8_t const pin);
+
+long random(long const max);
+long random(long const min, long const max);
+void randomSeed(unsigned long const seed);
+
+// Text output (Serial goes to the standard output)
+
+class Print {
+
+    public:
+
+        virtual ~Print() {}
+
+        virtual size_t write(uint8_t const c) = 0;
+
+        size_t write(uint8_t const *buffer, size_t size) { size_t n = 0; while (size--) n += write(*buffer++); return n; }
+
+        size_t print(char const c) { return write(c); }
+        size_t print(char const *text) { return write((uint8_t const *)text, strlen(text)); }
+        size_t print(__FlashStringHelper const *text) { return print((char const *)text); }
+        size_t println() { return print("\r\n"); }
+        size_t println(char const *text) { return print(text) + println(); }
+
+};
+
+class HostSerial : public Print {
+
+    public:
+
+        void   begin(unsigned long const) {}
+        size_t write(uint8_t const c) override { return fputc(c, stdout) == EOF ? 0 : 1; }
+
+};
+
+extern HostSerial Serial;
+
+/*
+ * ----------------------------------------------------------------------------
+ * ESPboy Library
+ * ----------------------------------------------------------------------------
+ * Copyright (c) 2021-2022 Stéphane Calderoni (https://github.com/m1cr0lab)
+ * 
+ * This program is free software: you can redistribute it and/or modify
+ * it under the terms of the GNU General Public License as published by
+ * the Free Software Foundation, either version 3 of the License, or
+ * (at your option) any later version.
+ * 
+ * This program is distributed in the hope that it will be useful,
+ * but WITHOUT ANY WARRANTY; without even the implied warranty of
+ * MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE. See the
+ * GNU General Public License for more details.
+ * 
+ * You should have received a copy of the GNU General Public License
+ * along with this program. If not, see <https://www.gnu.org/licenses/>.
+ * ----------------------------------------------------------------------------
+ */
\ No newline at end of file
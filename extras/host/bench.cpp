@@ -0,0 +1,335 @@
+/**
+ * ----------------------------------------------------------------------------
+ * @file   bench.cpp
+ * @author Stéphane Calderoni (https://github.com/m1cr0lab)
+ * @brief  Benchmarks of the per-frame hot paths of the library
+ * ----------------------------------------------------------------------------
+ * Runs each benchmark against the host stand-ins (make bench), and reports
+ * the time per operation along with the bytes sent per operation to the
+ * display (SPI), to the I/O expander and the DAC (I2C), and to the NeoPixel
+ * LED (UART symbols):
+ * 
+ *   build/bench                    runs all the benchmarks
+ *   build/bench life neopixel      runs those whose name contains one of the words
+ *   build/bench --tsv > base.tsv   writes tab-separated values
+ *   build/bench -b base.tsv        compares with a previous run, and fails if a
+ *                                  benchmark got more than 10% slower
+ *   build/bench -b base.tsv -t 5   ... or more than 5% slower
+ * 
+ * The time of an operation is the best of 5 batches lasting at least 20 ms
+ * each, measured with the wall clock, while the library runs in virtual time.
+ * ----------------------------------------------------------------------------
+ */
+
+#include <ESPboy.h>
+#include <chrono>
+#include <stdio.h>
+#include <stdlib.h>
+#include <string>
+#include <vector>
+
+static uint8_t  constexpr _RUNS         = 5;
+static double   constexpr _MIN_BATCH_NS = 20e6;
+static uint32_t constexpr _FRAME_US     = 16000;
+
+struct Traffic {
+
+    uint32_t spi; // bytes
+    uint32_t i2c;
+    uint32_t led;
+
+};
+
+struct Result {
+
+    std::string name;
+    double      ns;  // per operation
+    double      spi; // bytes per operation
+    double      i2c;
+    double      led;
+
+};
+
+static std::vector<char const *> _filters;
+static std::vector<Result>       _results;
+static volatile uint32_t         _sink; // keeps the results of the operations alive
+
+static Traffic _traffic() {
+
+    return {
+        espboy.tft.pushedPixels() << 1,
+        espboy.mcp.i2cBytes() + espboy.dac.i2cBytes(),
+        espboy.pixel.line().waveform.count()
+    };
+
+}
+
+static bool _selected(char const * const name) {
+
+    if (_filters.empty()) return true;
+    for (char const *f : _filters) if (strstr(name, f)) return true;
+
+    return false;
+
+}
+
+template <typename Op>
+static double _time(Op &op, uint32_t const n) {
+
+    auto const start = std::chrono::steady_clock::now();
+    for (uint32_t i = 0; i < n; ++i) op();
+
+    return std::chrono::duration<double, std::nano>(std::chrono::steady_clock::now() - start).count();
+
+}
+
+template <typename Op>
+static void _bench(char const * const name, Op op) {
+
+    if (!_selected(name)) return;
+
+    uint32_t n = 1;
+    while (_time(op, n) < _MIN_BATCH_NS && n < 1u << 30) n <<= 1;
+
+    Traffic const before = _traffic();
+
+    double best = _time(op, n);
+    for (uint8_t i = 1; i < _RUNS; ++i) { double const t = _time(op, n); if (t < best) best = t; }
+
+    Traffic const after = _traffic();
+    double  const ops   = (double)n * _RUNS;
+
+    _results.push_back({ name, best / n, (after.spi - before.spi) / ops, (after.i2c - before.i2c) / ops, (after.led - before.led) / ops });
+
+}
+
+// ----------------------------------------------------------------------------
+// Benchmarks
+// ----------------------------------------------------------------------------
+
+static void _run() {
+
+    {
+        static uint8_t constexpr PATTERN[] = { 0, 0, PAD_LEFT, PAD_LEFT, PAD_LEFT, PAD_LEFT, 0, PAD_ACT, 0, PAD_ACT, PAD_ACT, PAD_ACT, PAD_UP | PAD_ACT, PAD_UP, 0, 0 };
+
+        Button   button;
+        uint32_t i = 0;
+
+        _bench("button.read", [&] { button.read(PATTERN[i & 15], i); ++i; _sink += button.pressed(Button::ACT); });
+    }
+
+    {
+        uint16_t hue = 0;
+
+        _bench("color.hsv2rgb565",     [&] { _sink += Color::hsv2rgb565(hue, 200, 255); hue = hue == 359 ? 0 : hue + 1; });
+        _bench("color.hsv2rgb565Fast", [&] { _sink += Color::hsv2rgb565Fast(hue, 255);   hue = hue == 359 ? 0 : hue + 1; });
+    }
+
+    {
+        auto led = [] { hal::Clock::advance(1000); espboy.pixel.update(); };
+
+        espboy.pixel.reset();                     _bench("neopixel.idle",    led);
+        espboy.pixel.flash(0xff0000, 50, 0, 200); _bench("neopixel.flash",   led);
+        espboy.pixel.breathe(0x00ff00, 1000, 0);  _bench("neopixel.breathe", led);
+        espboy.pixel.rainbow(1000, 0);            _bench("neopixel.rainbow", led);
+        espboy.pixel.reset();
+    }
+
+    _bench("espboy.update", [] { hal::Clock::advance(_FRAME_US); espboy.update(); });
+
+    {
+        Scheduler scheduler;
+
+        for (uint8_t i = 0; i < Scheduler::MAX_TASKS; ++i) scheduler.every(17 + 13 * i, [] { _sink++; });
+
+        _bench("scheduler.run", [&] { hal::Clock::advance(_FRAME_US); scheduler.run(); });
+    }
+
+    hal::Sprite sprite(&espboy.tft);
+    sprite.createSprite(TFT_WIDTH, TFT_HEIGHT);
+
+    _bench("sprite.push", [&] { sprite.pushSprite(0, 0); });
+
+    {
+        FrameBuffer fb(espboy.tft);
+        uint8_t     x = 0;
+
+        if (fb.begin()) {
+            _bench("framebuffer.flush",       [&] { fb.invalidate(); fb.flush(); });
+            _bench("framebuffer.flush.dirty", [&] { fb.fillRect(x, x >> 1, 16, 16, x); x = (x + 1) & 0x7f; fb.flush(); });
+            fb.end();
+        }
+    }
+
+    {
+        DoubleBuffer db;
+
+        if (db.begin(espboy.tft, TFT_HEIGHT >> 1)) {
+            _bench("doublebuffer.present", [&] { db.present(0); db.present(TFT_HEIGHT >> 1); db.wait(); });
+            db.end();
+        }
+    }
+
+    {
+        PaletteBuffer pb(espboy.tft);
+
+        if (pb.begin(4)) {
+            _bench("palettebuffer.flush", [&] { pb.flush(); pb.wait(); });
+            pb.end();
+        }
+    }
+
+    {
+        Life life;
+
+        if (life.begin()) {
+            life.randomize();
+            _bench("life.step", [&] { life.step(); });
+            _bench("life.blit", [&] { life.blit(sprite); });
+            life.end();
+        }
+    }
+
+    {
+        Particles particles;
+        Random    rng;
+
+        if (particles.begin(8 * 64, 8)) {
+
+            _bench("fireworks.tick", [&] {
+
+                if (particles.count() < 256) {
+                    uint8_t const emitter = particles.createEmitter(rng.below(360), 2, Particles::q8(.1f), 3);
+                    if (emitter != Particles::NO_EMITTER) particles.burst(emitter, 64, 64, 64, rng, Particles::q8(3), Particles::q8(-5), Particles::q8(-1));
+                }
+
+                particles.update();
+                sprite.clear();
+                particles.draw(sprite);
+
+            });
+
+            particles.end();
+
+        }
+    }
+
+    {
+        Game2048 game;
+        Random   rng;
+
+        game.start(rng);
+
+        _bench("2048.move", [&] { if (!game.play(rng.below(4), rng) && game.over()) game.start(rng); _sink += game.tile(0, 0); });
+
+        game.start(rng);
+
+        _bench("2048.hint", [&] {
+            uint8_t const dir = game.hint(2000);
+            if (dir == Game2048::NO_MOVE) game.start(rng); else game.play(dir, rng);
+            _sink += game.tile(0, 0);
+        });
+    }
+
+}
+
+// ----------------------------------------------------------------------------
+// Reports
+// ----------------------------------------------------------------------------
+
+static void _print(bool const tsv, std::vector<Result> const &baseline, double const tolerance, bool &regression) {
+
+    if (tsv) printf("# benchmark\tns/op\tspi B/op\ti2c B/op\tled B/op\n");
+    else     printf("%-26s %12s %10s %10s %10s%s\n", "benchmark", "ns/op", "SPI B/op", "I2C B/op", "LED B/op", baseline.empty() ? "" : "   vs base");
+
+    for (Result const &r : _results) {
+
+        if (tsv) { printf("%s\t%.1f\t%.1f\t%.2f\t%.2f\n", r.name.c_str(), r.ns, r.spi, r.i2c, r.led); continue; }
+
+        printf("%-26s %12.1f %10.1f %10.2f %10.2f", r.name.c_str(), r.ns, r.spi, r.i2c, r.led);
+
+        for (Result const &b : baseline) {
+            if (b.name != r.name) continue;
+            double const delta = 100 * (r.ns - b.ns) / b.ns;
+            bool   const slower = delta > tolerance;
+            printf("   %+7.1f%%%s", delta, slower ? " !" : "");
+            regression |= slower;
+        }
+
+        printf("\n");
+
+    }
+
+}
+
+static bool _load(char const * const path, std::vector<Result> &baseline) {
+
+    FILE *file = fopen(path, "r");
+    if (!file) return false;
+
+    char line[256];
+
+    while (fgets(line, sizeof(line), file)) {
+        if (line[0] == '#') continue;
+        char   name[64];
+        Result r;
+        if (sscanf(line, "%63s %lf %lf %lf %lf", name, &r.ns, &r.spi, &r.i2c, &r.led) != 5 || r.ns <= 0) continue;
+        r.name = name;
+        baseline.push_back(r);
+    }
+
+    fclose(file);
+
+    return true;
+
+}
+
+int main(int argc, char **argv) {
+
+    bool                tsv       = false;
+    double              tolerance = 10;
+    std::vector<Result> baseline;
+
+    for (int i = 1; i < argc; ++i) {
+        if      (!strcmp(argv[i], "--tsv")) tsv = true;
+        else if (!strcmp(argv[i], "-t") && i + 1 < argc) tolerance = atof(argv[++i]);
+        else if (!strcmp(argv[i], "-b") && i + 1 < argc) {
+            if (!_load(argv[++i], baseline)) { fprintf(stderr, "bench: can't read %s\n", argv[i]); return 2; }
+        }
+        else if (argv[i][0] == '-') { fprintf(stderr, "usage: %s [--tsv] [-b BASELINE] [-t PERCENT] [NAME...]\n", argv[0]); return 2; }
+        else _filters.push_back(argv[i]);
+    }
+
+    hal::Clock::useVirtualTime(true);
+    espboy.setBootPolicy(BootPolicy::NO_SPLASH);
+    espboy.begin();
+
+    _run();
+
+    bool regression = false;
+    _print(tsv, baseline, tolerance, regression);
+
+    return regression ? 1 : 0;
+
+}
+
+/*
+ * ----------------------------------------------------------------------------
+ * ESPboy Library
+ * ----------------------------------------------------------------------------
+ * Copyright (c) 2021-2022 Stéphane Calderoni (https://github.com/m1cr0lab)
+ * 
+ * This program is free software: you can redistribute it and/or modify
+ * it under the terms of the GNU General Public License as published by
+ * the Free Software Foundation, either version 3 of the License, or
+ * (at your option) any later version.
+ * 
+ * This program is distributed in the hope that it will be useful,
+ * but WITHOUT ANY WARRANTY; without even the implied warranty of
+ * MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE. See the
+ * GNU General Public License for more details.
+ * 
+ * You should have received a copy of the GNU General Public License
+ * along with this program. If not, see <https://www.gnu.org/licenses/>.
+ * ----------------------------------------------------------------------------
+ */
\ No newline at end of file
@@ -0,0 +1,732 @@
+/**
+ * ----------------------------------------------------------------------------
+ * @file   check.cpp
+ * @author Stéphane Calderoni (https://github.com/m1cr0lab)
+ * @brief  Checks of the library on the host
+ * ----------------------------------------------------------------------------
+ * Runs a few checks of the library against the host stand-ins (make check),
+ * prints the ones that fail, and exits 1 if any does.
+ * ----------------------------------------------------------------------------
+ */
+
+#include <ESPboy.h>
+#include <stdio.h>
+#include <vector>
+
+static uint32_t _checks;
+static uint32_t _failures;
+
+#define CHECK_EQ(actual, expected) _check((actual), (expected), #actual, __LINE__)
+
+static void _check(uint32_t const actual, uint32_t const expected, char const * const what, int const line) {
+
+    _checks++;
+
+    if (actual == expected) return;
+
+    _failures++;
+    fprintf(stderr, "check.cpp:%d: %s is %u, expected %u\n", line, what, (unsigned)actual, (unsigned)expected);
+
+}
+
+// ----------------------------------------------------------------------------
+// Button
+// ----------------------------------------------------------------------------
+
+/**
+ * @brief One button debounced on its own, with a counter and a state machine.
+ */
+struct _ButtonModel {
+
+    enum class State : uint8_t { FREE, PRESSED, HELD, RELEASED };
+
+    uint8_t  integrator    = 0;
+    bool     output        = false;
+    State    state         = State::FREE;
+    uint32_t held_start_ms = 0; // time of the debounced press
+
+    void read(bool const reading, uint32_t const ms) {
+
+             if (!reading) { if (integrator) integrator--; }
+        else if (integrator < 3) integrator++;
+
+        bool const last = output;
+
+        output = integrator == 3;
+        if (output && !last) held_start_ms = ms;
+
+        switch (state) {
+            case State::FREE:     if (output) state = State::PRESSED;             break;
+            case State::PRESSED:  state = output ? State::HELD : State::RELEASED; break;
+            case State::HELD:     if (!output) state = State::RELEASED;           break;
+            case State::RELEASED: state = State::FREE;                            break;
+        }
+
+    }
+
+    bool held(uint32_t const ms, uint32_t const delay_ms) const {
+
+        return state == State::HELD && ms - held_start_ms >= delay_ms;
+
+    }
+
+};
+
+static void _checkButton() {
+
+    Button       button;
+    _ButtonModel model[8];
+    Random       rng(3);
+    uint8_t      level  = 0;
+    uint8_t      bounce[8] {};
+    uint32_t     errors = 0;
+
+    // a clean press is debounced after 3 reads, and held from then on
+    button.read(0x01); button.read(0x01);
+    CHECK_EQ(button.pressedMask(), 0x00);
+    button.read(0x01);
+    CHECK_EQ(button.pressedMask(), 0x01);
+    button.read(0x01);
+    CHECK_EQ(button.heldMask(), 0x01);
+    button.read(0x00);
+    CHECK_EQ(button.releasedMask(), 0x01);
+
+    button = Button();
+
+    // buttons going up and down at random, bouncing for a few reads each time
+    for (uint16_t t = 0; t < 4000; ++t) {
+
+        for (uint8_t i = 0; i < 8; ++i) {
+            if (!rng.below(40)) { level ^= 1 << i; bounce[i] = 4; }
+        }
+
+        uint8_t input = level;
+        for (uint8_t i = 0; i < 8; ++i) {
+            if (bounce[i]) { bounce[i]--; if (rng.below(2)) input ^= 1 << i; }
+        }
+
+        hal::Clock::advance(1000);
+        button.read(input);
+
+        uint32_t const ms = millis();
+        uint8_t pressed = 0, held = 0, released = 0;
+
+        for (uint8_t i = 0; i < 8; ++i) {
+            model[i].read(input & 1 << i, ms);
+            if (model[i].state == _ButtonModel::State::PRESSED)  pressed  |= 1 << i;
+            if (model[i].state == _ButtonModel::State::HELD)     held     |= 1 << i;
+            if (model[i].state == _ButtonModel::State::RELEASED) released |= 1 << i;
+            if (button.held(i, 20) != model[i].held(ms, 20)) errors++;
+        }
+
+        if (button.pressedMask() != pressed || button.heldMask() != held || button.releasedMask() != released) errors++;
+
+    }
+
+    CHECK_EQ(errors, 0);
+
+}
+
+static void _checkButtonEvents() {
+
+    Button      button;
+    ButtonEvent event;
+
+    button.enableEvents();
+    CHECK_EQ(button.nextEvent(event), false);
+
+    // the events come in the order of the debounced changes, with the time of
+    // the sample that made them, and by button within a sample
+    button.sample(0x01, 100);
+    button.sample(0x03, 200);
+    button.sample(0x03, 300);
+    button.sample(0x02, 400);
+    CHECK_EQ(button.pendingEvents(), 3);
+
+    uint32_t const expected[3][3] = { { 300, 0, true }, { 400, 0, false }, { 400, 1, true } };
+
+    for (uint8_t i = 0; i < 3; ++i) {
+        CHECK_EQ(button.nextEvent(event), true);
+        CHECK_EQ(event.us, expected[i][0]);
+        CHECK_EQ(event.button, expected[i][1]);
+        CHECK_EQ(event.pressed, expected[i][2]);
+    }
+
+    CHECK_EQ(button.nextEvent(event), false);
+
+    // 24 changes without draining: the last 8 don't fit in the queue
+    button = Button();
+    button.enableEvents();
+    for (uint8_t i = 0; i < 3; ++i) button.sample(0xff, 1000 + i);
+    button.sample(0x00, 2000);
+    for (uint8_t i = 0; i < 3; ++i) button.sample(0xff, 3000 + i);
+
+    CHECK_EQ(button.pendingEvents(), 16);
+    CHECK_EQ(button.lostEvents(), 8);
+
+    uint8_t popped = 0;
+    while (button.nextEvent(event)) {
+        if (event.button != popped % 8 || event.pressed != (popped < 8)) break;
+        popped++;
+    }
+
+    CHECK_EQ(popped, 16);
+    CHECK_EQ(event.us, 2000);
+    CHECK_EQ(button.pendingEvents(), 0);
+
+}
+
+// ----------------------------------------------------------------------------
+// FramePacer
+// ----------------------------------------------------------------------------
+
+/**
+ * @brief Frame statistics of n frames lasting first_us, first_us + 1, ... microseconds.
+ */
+static FrameStats _frames(uint16_t const n, uint32_t const first_us) {
+
+    FramePacer pacer;
+
+    pacer.begin();
+
+    for (uint16_t i = 0; i < n; ++i) {
+        hal::Clock::advance(first_us + i);
+        pacer.pace();
+    }
+
+    return pacer.stats();
+
+}
+
+static void _checkFramePacer() {
+
+    // nearest rank: the ceil(0.99 * n)-th shortest frame
+    FrameStats s = _frames(100, 1);
+    CHECK_EQ(s.frames, 100);
+    CHECK_EQ(s.p99_us, 99);
+    CHECK_EQ(s.max_us, 100);
+
+    s = _frames(200, 1);
+    CHECK_EQ(s.frames, 200);
+    CHECK_EQ(s.p99_us, 198);
+    CHECK_EQ(s.min_us, 1);
+
+    s = _frames(1, 7);
+    CHECK_EQ(s.p99_us, 7);
+
+    // only the last 256 frames are kept: 45 to 300 us
+    s = _frames(300, 1);
+    CHECK_EQ(s.frames, 256);
+    CHECK_EQ(s.min_us, 45);
+    CHECK_EQ(s.p99_us, 298);
+
+}
+
+// ----------------------------------------------------------------------------
+// FrameBuffer
+// ----------------------------------------------------------------------------
+
+/**
+ * @brief Draws a 4x4 board of 27x27 tiles, as 9-2048 does at each frame.
+ */
+static void _drawBoard(FrameBuffer &fb, uint8_t const lit) {
+
+    fb.clear(0x8410);
+
+    for (uint8_t i = 0; i < 16; ++i) {
+        fb.fillRoundRect((i & 3) * 31 + 4, (i >> 2) * 31 + 4, 27, 27, 3, i == lit ? 0xffe0 : 0xc618);
+    }
+
+    fb.flush();
+
+}
+
+static void _checkFrameBuffer() {
+
+    FrameBuffer fb(espboy.tft);
+
+    fb.begin(true);
+    espboy.tft.resetStats();
+
+    // the first frame is pushed whole, then only what has changed
+    _drawBoard(fb, 0);
+    CHECK_EQ(espboy.tft.pushedPixels(), 128 * 128);
+
+    for (uint8_t i = 0; i < 10; ++i) _drawBoard(fb, 0);
+    CHECK_EQ(espboy.tft.pushedPixels(), 128 * 128);
+
+    // another tile lit: only the 4x4 blocks of 8x8 pixels under each of the two tiles
+    _drawBoard(fb, 5);
+    CHECK_EQ(espboy.tft.pushedPixels() - 128 * 128, 2 * 4 * 4 * 64);
+
+    fb.end();
+
+}
+
+// ----------------------------------------------------------------------------
+// PaletteBuffer
+// ----------------------------------------------------------------------------
+
+static void _checkPaletteBuffer() {
+
+    PaletteBuffer pb(espboy.tft);
+
+    pb.begin(4);
+    for (uint8_t i = 0; i < 16; ++i) pb.setColor(i, i);
+
+    // a range running past the end of the palette is cut at its end
+    pb.rotatePalette(14, 16, 1);
+    CHECK_EQ(pb.color(13), 13);
+    CHECK_EQ(pb.color(14), 15);
+    CHECK_EQ(pb.color(15), 14);
+
+    pb.rotatePalette(250, 16, 1);
+    CHECK_EQ(pb.color(15), 14);
+
+    pb.end();
+
+}
+
+// ----------------------------------------------------------------------------
+// Life
+// ----------------------------------------------------------------------------
+
+/**
+ * @brief Generations of a w x h universe computed by Life and cell by cell,
+ *        with one byte per cell and dead cells around the grid.
+ * 
+ * @return The number of cells that differ, over all the generations.
+ */
+static uint32_t _lifeMismatches(uint16_t const w, uint16_t const h, uint16_t const generations) {
+
+    Life life(w, h);
+
+    if (!life.begin()) return 1;
+
+    life.randomize(3);
+
+    std::vector<uint8_t> cell(w * h), next(w * h);
+    for (uint16_t y = 0; y < h; ++y) for (uint16_t x = 0; x < w; ++x) cell[y * w + x] = life.get(x, y);
+
+    uint32_t mismatches = 0;
+
+    for (uint16_t g = 0; g < generations; ++g) {
+
+        life.step();
+
+        for (int16_t y = 0; y < h; ++y) {
+            for (int16_t x = 0; x < w; ++x) {
+
+                uint8_t n = 0;
+                for (int8_t dy = -1; dy <= 1; ++dy) for (int8_t dx = -1; dx <= 1; ++dx) {
+                    int16_t const i = x + dx, j = y + dy;
+                    if ((dx || dy) && i >= 0 && i < w && j >= 0 && j < h) n += cell[j * w + i];
+                }
+
+                next[y * w + x] = n == 3 || (n == 2 && cell[y * w + x]);
+
+            }
+        }
+
+        cell.swap(next);
+
+        for (uint16_t y = 0; y < h; ++y) for (uint16_t x = 0; x < w; ++x) mismatches += life.get(x, y) != cell[y * w + x];
+
+    }
+
+    return mismatches;
+
+}
+
+static void _checkLife() {
+
+    // single rows and words, and cells on the edges of the grid, which must not wrap around
+    CHECK_EQ(_lifeMismatches( 32,   1,  50), 0);
+    CHECK_EQ(_lifeMismatches( 32,   2,  50), 0);
+    CHECK_EQ(_lifeMismatches( 64,   3, 100), 0);
+    CHECK_EQ(_lifeMismatches( 96,  17, 300), 0);
+    CHECK_EQ(_lifeMismatches(128, 128, 300), 0);
+
+}
+
+// ----------------------------------------------------------------------------
+// Particles
+// ----------------------------------------------------------------------------
+
+static void _checkParticles() {
+
+    Particles particles;
+
+    particles.begin(16, 2);
+
+    uint8_t const emitter = particles.createEmitter(0);
+    CHECK_EQ(particles.spawn(emitter, 64, 64, 0, 0), true);
+
+    // the emitter is released with its last particle, and can't spawn anymore
+    for (uint16_t i = 0; i < 100; ++i) particles.update();
+    CHECK_EQ(particles.count(), 0);
+    CHECK_EQ(particles.spawn(emitter, 64, 64, 0, 0), false);
+
+    // until it's created again
+    CHECK_EQ(particles.createEmitter(0), emitter);
+    CHECK_EQ(particles.spawn(emitter, 64, 64, 0, 0), true);
+    CHECK_EQ(particles.count(), 1);
+
+    particles.end();
+
+}
+
+// ----------------------------------------------------------------------------
+// NeoPixel
+// ----------------------------------------------------------------------------
+
+static void _checkNeoPixel() {
+
+    espboy.pixel.begin(espboy.mcp);
+
+    // a finite rainbow turns the LED off once done
+    espboy.pixel.rainbow(1000, 2);
+    for (uint16_t ms = 0; ms < 2100; ++ms) { hal::Clock::advance(1000); espboy.pixel.update(); }
+
+    CHECK_EQ(espboy.pixel.playing(), false);
+    CHECK_EQ(espboy.pixel.line().frames.last(), 0);
+
+    // a frame sent right after another one waits for the LED to latch it
+    uint32_t const frames = espboy.pixel.line().frames.count();
+
+    espboy.pixel.show(0xff0000);
+
+    uint32_t const start_us = micros();
+    espboy.pixel.show(0x00ff00);
+
+    CHECK_EQ(micros() - start_us >= 300, true);
+    CHECK_EQ(espboy.pixel.line().frames.count(), frames + 2);
+
+}
+
+// ----------------------------------------------------------------------------
+// Asset
+// ----------------------------------------------------------------------------
+
+// the logos of 2-splash-screen, without its setup() and loop()
+namespace splash {
+#define setup setup_
+#define loop  loop_
+#include "../../examples/2-splash-screen/2-splash-screen.ino"
+#undef setup
+#undef loop
+}
+
+// 10x3 monochromatic asset, with transparent zeros and raw pixels
+static uint8_t const constexpr _MONO_ASSET[] PROGMEM = { 0x81, 10, 3, 0, 0, 0xc0, 0x4f, 0xca, 0xa8 };
+static char    const           _MONO_ROWS[]          = "1100000001" "0011111100" "1010101010";
+
+/**
+ * @brief Color of a pixel of the colormap of 2-splash-screen, in the byte order of the decoded rows.
+ */
+static uint16_t _colormap(uint8_t const x, uint8_t const y) {
+
+    // the colormap holds its colors with their bytes swapped, as the display receives them
+    uint16_t const c = pgm_read_word(splash::COLORMAP + y * 35 + x);
+
+    return hal::displayOrder(c >> 8 | c << 8);
+
+}
+
+static void _checkAsset() {
+
+    Asset const logo(splash::LOGO_ASSET);
+    uint16_t    row[35];
+    uint32_t    errors = 0;
+
+    CHECK_EQ(logo.size(), sizeof(splash::LOGO_ASSET));
+    CHECK_EQ(logo.width(), 35);
+    CHECK_EQ(logo.height(), 38);
+
+    AssetReader reader(logo);
+
+    for (uint8_t y = 0; y < 38; ++y) {
+        reader.read(row);
+        for (uint8_t x = 0; x < 35; ++x) errors += row[x] != _colormap(x, y);
+    }
+
+    CHECK_EQ(errors, 0);
+
+    // the rows skipped are decoded all the same, without their colors
+    reader.rewind();
+    reader.skip(20);
+    reader.read(row);
+
+    errors = 0;
+    for (uint8_t x = 0; x < 35; ++x) errors += row[x] != _colormap(x, 20);
+
+    CHECK_EQ(errors, 0);
+
+    Asset const mono(_MONO_ASSET);
+    AssetReader mono_reader(mono);
+
+    CHECK_EQ(mono.size(), sizeof(_MONO_ASSET));
+    CHECK_EQ(mono.transparent(), true);
+
+    // the zeros take the transparent color, which differs from the drawing color
+    uint16_t const color = 0x07e0;
+    uint16_t const key   = mono_reader.key(color);
+    CHECK_EQ(key != hal::displayOrder(color), true);
+
+    errors = 0;
+
+    for (uint8_t y = 0; y < 3; ++y) {
+        mono_reader.read(row, color);
+        for (uint8_t x = 0; x < 10; ++x) errors += row[x] != (_MONO_ROWS[y * 10 + x] == '1' ? hal::displayOrder(color) : key);
+    }
+
+    CHECK_EQ(errors, 0);
+
+    mono_reader.rewind();
+    mono_reader.skip(2);
+    mono_reader.read(row, color);
+    CHECK_EQ(row[0], hal::displayOrder(color));
+    CHECK_EQ(row[1], key);
+
+}
+
+// ----------------------------------------------------------------------------
+// TileMap
+// ----------------------------------------------------------------------------
+
+static uint16_t _TILES[2 * 64];
+
+static void _checkTileMap() {
+
+    TileMap map(espboy.tft);
+    uint8_t tiles[16 * 16] = {};
+
+    map.begin(TileSheet(_TILES), tiles, 16, 16);
+    map.render();
+
+    int8_t const id = map.addSprite(TileSheet(_TILES), 1, 60, 60);
+    for (uint8_t i = 1; i < TileMap::MAX_SPRITES; ++i) map.addSprite(TileSheet(_TILES), 1, 0, 0);
+    map.render();
+
+    // the sprite pool is full, and the -1 returned is ignored
+    int8_t const none = map.addSprite(TileSheet(_TILES), 1, 0, 0);
+    CHECK_EQ(none, -1);
+    map.removeSprite(none);
+    map.moveSprite(none, 100, 100);
+    map.setSpriteFrame(none, 0);
+    map.setSpriteZ(none, 1);
+    map.showSprite(none, false);
+    map.render();
+    CHECK_EQ(map.renderedPixels(), 0);
+
+    // so is a removed sprite
+    map.removeSprite(1);
+    map.render();
+    map.moveSprite(1, 100, 100);
+    map.render();
+    CHECK_EQ(map.renderedPixels(), 0);
+
+    // while an existing one is still moved (from 2x2 cells to a single one)
+    map.moveSprite(id, 80, 80);
+    map.render();
+    CHECK_EQ(map.renderedPixels(), (4 + 1) * 64);
+
+    map.end();
+
+}
+
+// ----------------------------------------------------------------------------
+// Scheduler
+// ----------------------------------------------------------------------------
+
+static void _task() {}
+
+static void _checkScheduler() {
+
+    FramePacer pacer;
+    Scheduler  scheduler;
+
+    pacer.begin();
+    pacer.pace();
+
+    scheduler.setBudget(2000);
+    scheduler.after(1, _task, TaskPriority::BACKGROUND);
+
+    // the frame has already spent 3 ms of its 2 ms budget before the tasks
+    hal::Clock::advance(3000);
+
+    scheduler.run(pacer.frameStart());
+    CHECK_EQ(scheduler.ran(), 0);
+    CHECK_EQ(scheduler.deferred(), 1);
+
+    // the next frame starts within its budget
+    pacer.pace();
+    scheduler.run(pacer.frameStart());
+    CHECK_EQ(scheduler.ran(), 1);
+    CHECK_EQ(scheduler.deferred(), 0);
+
+    // begin() gives up as long as a button is held, but publishes the FPS only once
+    espboy.mcp.setButtons(PAD_ACT);
+    espboy.begin();
+    espboy.begin();
+    espboy.mcp.setButtons(0);
+    espboy.begin();
+    CHECK_EQ(espboy.scheduler.count(), 1);
+
+}
+
+// ----------------------------------------------------------------------------
+// Game2048
+// ----------------------------------------------------------------------------
+
+// naive move of the tiles, one line of 4 cells after the other (the 2^15
+// tiles don't merge, as they couldn't be stored in a nibble)
+static void _slide(uint8_t board[4][4], uint8_t const dir) {
+
+    for (uint8_t k = 0; k < 4; ++k) {
+
+        uint8_t *cell[4];
+
+        for (uint8_t j = 0; j < 4; ++j) switch (dir) {
+            case Game2048::LEFT:  cell[j] = &board[k][j];     break;
+            case Game2048::RIGHT: cell[j] = &board[k][3 - j]; break;
+            case Game2048::UP:    cell[j] = &board[j][k];     break;
+            default:              cell[j] = &board[3 - j][k];
+        }
+
+        uint8_t line[4] {};
+        uint8_t n = 0;
+
+        for (uint8_t j = 0; j < 4; ++j) if (*cell[j]) line[n++] = *cell[j];
+
+        for (uint8_t j = 0; j + 1 < n; ++j) {
+            if (line[j] != line[j + 1] || line[j] == 0xf) continue;
+            line[j]++;
+            for (uint8_t i = j + 1; i + 1 < n; ++i) line[i] = line[i + 1];
+            line[--n] = 0;
+        }
+
+        for (uint8_t j = 0; j < 4; ++j) *cell[j] = line[j];
+
+    }
+
+}
+
+static uint32_t _moveMismatches(uint32_t const boards) {
+
+    Game2048 game;
+    Random   rng(7);
+    uint32_t errors = 0;
+
+    for (uint32_t b = 0; b < boards; ++b) {
+
+        uint8_t board[4][4];
+
+        // few distinct tiles, so that many of them merge
+        for (uint8_t row = 0; row < 4; ++row) for (uint8_t col = 0; col < 4; ++col) {
+            uint8_t const t = rng.below(6);
+            board[row][col] = t < 4 ? t : (t == 4 ? 0xf : 0);
+        }
+
+        for (uint8_t dir = 0; dir < 4; ++dir) {
+
+            uint8_t slid[4][4];
+            memcpy(slid, board, sizeof(slid));
+            _slide(slid, dir);
+
+            game.clear();
+            for (uint8_t row = 0; row < 4; ++row) for (uint8_t col = 0; col < 4; ++col) game.set(row, col, board[row][col]);
+
+            bool const moved = game.move(dir);
+
+            if (moved != (memcmp(slid, board, sizeof(slid)) != 0)) errors++;
+
+            for (uint8_t row = 0; row < 4; ++row) for (uint8_t col = 0; col < 4; ++col) {
+                if (game.tile(row, col) != slid[row][col]) errors++;
+            }
+
+        }
+
+    }
+
+    return errors;
+
+}
+
+static void _checkGame2048() {
+
+    CHECK_EQ(_moveMismatches(10000), 0);
+
+    Game2048 game;
+    Random   rng(11);
+
+    // a tiny budget still gives a move, which is legal
+    uint32_t illegal = 0;
+
+    for (uint32_t n = 0; n < 1000; ++n) {
+
+        game.start(rng);
+        for (uint16_t i = rng.below(200); i && !game.over(); --i) game.play(rng.below(4), rng);
+        if (game.over()) continue;
+
+        for (uint32_t budget = 0; budget < 6; ++budget) {
+            Game2048 copy = game;
+            if (!copy.move(game.hint(budget))) illegal++;
+        }
+
+    }
+
+    CHECK_EQ(illegal, 0);
+
+    // and no move is left on a board which is over
+    game.clear();
+    for (uint8_t row = 0; row < 4; ++row) for (uint8_t col = 0; col < 4; ++col) game.set(row, col, 1 + ((row + col) & 1));
+    CHECK_EQ(game.over(), true);
+    CHECK_EQ(game.hint(0), Game2048::NO_MOVE);
+    CHECK_EQ(game.hint(), Game2048::NO_MOVE);
+
+}
+
+int main() {
+
+    hal::Clock::useVirtualTime(true);
+
+    _checkButton();
+    _checkButtonEvents();
+    _checkFramePacer();
+    _checkFrameBuffer();
+    _checkPaletteBuffer();
+    _checkLife();
+    _checkParticles();
+    _checkNeoPixel();
+    _checkAsset();
+    _checkTileMap();
+    _checkScheduler();
+    _checkGame2048();
+
+    printf("%u checks, %u failed\n", (unsigned)_checks, (unsigned)_failures);
+
+    return _failures ? 1 : 0;
+
+}
+
+/*
+ * ----------------------------------------------------------------------------
+ * ESPboy Library
+ * ----------------------------------------------------------------------------
+ * Copyright (c) 2021-2022 Stéphane Calderoni (https://github.com/m1cr0lab)
+ * 
+ * This program is free software: you can redistribute it and/or modify
+ * it under the terms of the GNU General Public License as published by
+ * the Free Software Foundation, either version 3 of the License, or
+ * (at your option) any later version.
+ * 
+ * This program is distributed in the hope that it will be useful,
+ * but WITHOUT ANY WARRANTY; without even the implied warranty of
+ * MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE. See the
+ * GNU General Public License for more details.
+ * 
+ * You should have received a copy of the GNU General Public License
+ * along with this program. If not, see <https://www.gnu.org/licenses/>.
+ * ----------------------------------------------------------------------------
+ */
\ No newline at end of file
@@ -0,0 +1,207 @@
+/**
+ * ----------------------------------------------------------------------------
+ * @file   replay.cpp
+ * @author Stéphane Calderoni (https://github.com/m1cr0lab)
+ * @brief  Headless replay of recorded game sessions
+ * ----------------------------------------------------------------------------
+ * Linked with a sketch (make replay SKETCH=...), plays a session recorded by
+ * InputLog as fast as possible, in virtual time, and reports how long it took
+ * along with a hash of the final screen, so that two runs of the same session
+ * can be compared bit for bit:
+ * 
+ *   build/replay session.h              replays a log written by InputLog::dump()
+ *   build/replay -r 10000 session.h 42  plays 10000 frames with random presses
+ *                                       of the buttons (seed 42), and writes
+ *                                       the log of the session
+ * 
+ * The loop() function of the sketch must call espboy.update() once per frame.
+ * ----------------------------------------------------------------------------
+ */
+
+#include <ESPboy.h>
+#include <chrono>
+#include <stdio.h>
+#include <stdlib.h>
+#include <vector>
+
+void setup();
+void loop();
+
+static uint32_t constexpr _FRAME_US = 16000; // frame period of the recorded sessions
+
+class FilePrint : public Print {
+
+    private:
+
+        FILE *_file;
+
+    public:
+
+        FilePrint(FILE * const file) : _file(file) {}
+
+        size_t write(uint8_t const c) override { return fputc(c, _file) == EOF ? 0 : 1; }
+
+};
+
+/**
+ * @brief Reads the bytes of a C array written by InputLog::dump().
+ */
+static std::vector<uint8_t> _load(char const * const path) {
+
+    std::vector<uint8_t> log;
+
+    FILE *file = fopen(path, "r");
+    if (!file) return log;
+
+    std::vector<char> text;
+    int c;
+    while ((c = fgetc(file)) != EOF) text.push_back(c);
+    text.push_back(0);
+    fclose(file);
+
+    for (char const *p = text.data(); *p; ++p) {
+        if (p[0] == '/' && p[1] == '/') { while (*p && *p != '\n') ++p; if (!*p) break; }
+        else if (p[0] == '0' && p[1] == 'x') log.push_back(strtoul(p, (char **)&p, 16)), --p;
+    }
+
+    return log;
+
+}
+
+/**
+ * @brief FNV-1a hash of the pixels shown on the screen.
+ */
+static uint32_t _screenHash() {
+
+    uint32_t hash = 0x811c9dc5;
+
+    for (uint8_t y = 0; y < TFT_HEIGHT; ++y)
+        for (uint8_t x = 0; x < TFT_WIDTH; ++x) {
+            uint16_t const color = espboy.tft.shown(x, y);
+            hash = (hash ^ (color & 0xff)) * 0x01000193;
+            hash = (hash ^ (color >> 8))   * 0x01000193;
+        }
+
+    return hash;
+
+}
+
+/**
+ * @brief Presses the buttons at random: a direction or ACT held for 4 to 9
+ *        frames, then nothing for 4 to 29 frames.
+ */
+static uint8_t _randomButtons(Random &rng) {
+
+    static uint8_t constexpr KEYS[] = { PAD_LEFT, PAD_UP, PAD_DOWN, PAD_RIGHT, PAD_ACT };
+
+    static uint8_t  mask = 0;
+    static uint32_t left = 0;
+
+    if (!left) {
+        mask = mask ? 0 : KEYS[rng.below(sizeof(KEYS))];
+        left = mask ? rng.range(4, 10) : rng.range(4, 30);
+    }
+
+    left--;
+
+    return mask;
+
+}
+
+static int _record(uint32_t const frames, char const * const path, uint32_t const seed) {
+
+    FILE *file = fopen(path, "w");
+    if (!file) { fprintf(stderr, "replay: can't write %s\n", path); return 1; }
+
+    std::vector<uint8_t> buffer(InputLog::HEADER_SIZE + 6 * (size_t)frames);
+    Random rng(seed);
+
+    espboy.input.record(buffer.data(), buffer.size(), seed);
+    setup();
+
+    uint32_t const start_us = micros();
+
+    for (uint32_t i = 0; i < frames; ++i) {
+        espboy.mcp.setButtons(_randomButtons(rng));
+        loop();
+        // the frames keep a steady period, whatever time the frame took
+        int32_t const ahead = start_us + (i + 1) * _FRAME_US - micros();
+        if (ahead > 0) hal::Clock::advance(ahead);
+    }
+
+    espboy.input.stop();
+
+    FilePrint out(file);
+    espboy.input.dump(out);
+    fclose(file);
+
+    fprintf(stderr, "%u frames recorded into %s (%zu bytes), screen 0x%08x\n", (unsigned)espboy.input.frames(), path, espboy.input.size(), (unsigned)_screenHash());
+
+    return 0;
+
+}
+
+static int _replay(char const * const path) {
+
+    std::vector<uint8_t> const log = _load(path);
+
+    if (!espboy.input.replay(log.data(), log.size())) { fprintf(stderr, "replay: %s is not a session log\n", path); return 1; }
+
+    setup();
+    espboy.tft.resetStats();
+
+    auto const start = std::chrono::steady_clock::now();
+
+    // stops right after the last recorded frame, which the game must not outlive
+    while (espboy.input.replaying() && espboy.input.played() < espboy.input.frames()) loop();
+
+    double const elapsed_us = std::chrono::duration<double, std::micro>(std::chrono::steady_clock::now() - start).count();
+    uint32_t const played   = espboy.input.played();
+
+    printf(
+        "%u frames in %.1f ms (%.2f us per frame), %u pixels pushed, screen 0x%08x\n",
+        (unsigned)played,
+        elapsed_us / 1000,
+        played ? elapsed_us / played : 0,
+        (unsigned)espboy.tft.pushedPixels(),
+        (unsigned)_screenHash()
+    );
+
+    return 0;
+
+}
+
+int main(int argc, char **argv) {
+
+    hal::Clock::useVirtualTime(true);
+    espboy.setBootPolicy(BootPolicy::NO_SPLASH);
+
+    if (argc >= 4 && !strcmp(argv[1], "-r")) return _record(strtoul(argv[2], nullptr, 10), argv[3], argc > 4 ? strtoul(argv[4], nullptr, 10) : 1);
+    if (argc == 2) return _replay(argv[1]);
+
+    fprintf(stderr, "usage: %s LOG | -r FRAMES LOG [SEED]\n", argv[0]);
+
+    return 2;
+
+}
+
+/*
+ * ----------------------------------------------------------------------------
+ * ESPboy Library
+ * ----------------------------------------------------------------------------
+ * Copyright (c) 2021-2022 Stéphane Calderoni (https://github.com/m1cr0lab)
+ * 
+ * This program is free software: you can redistribute it and/or modify
+ * it under the terms of the GNU General Public License as published by
+ * the Free Software Foundation, either version 3 of the License, or
+ * (at your option) any later version.
+ * 
+ * This program is distributed in the hope that it will be useful,
+ * but WITHOUT ANY WARRANTY; without even the implied warranty of
+ * MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE. See the
+ * GNU General Public License for more details.
+ * 
+ * You should have received a copy of the GNU General Public License
+ * along with this program. If not, see <https://www.gnu.org/licenses/>.
+ * ----------------------------------------------------------------------------
+ */
\ No newline at end of file
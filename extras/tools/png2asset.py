@@ -0,0 +1,255 @@
+#!/usr/bin/env python3
+# ------------------------------------------------------------------------------
+# PNG to ESPboy asset converter
+# ------------------------------------------------------------------------------
+# Converts a PNG image into a compressed asset (see src/Asset.h), written as a
+# byte array stored in flash memory, ready to be included in a sketch:
+#
+#   png2asset.py logo.png                  palette (or RGB565) image
+#   png2asset.py --mono logo.png           monochromatic bitmap
+#   png2asset.py --name LOGO -o logo.h logo.png
+#
+# The image is palettized whenever it has no more than 256 RGB565 colors, with
+# the smallest depth that fits (1, 2, 4 or 8 bits per pixel), and its pixels
+# are run-length encoded unless it makes the asset larger (or --raw is given).
+# Pixels whose alpha is below 128 are transparent.
+#
+# Only the Python standard library is needed: non-interlaced PNG files of any
+# color type are supported, with 8-bit channels (or 1, 2, 4-bit palettes and
+# gray levels).
+# ------------------------------------------------------------------------------
+
+import argparse
+import collections
+import os
+import re
+import struct
+import sys
+import zlib
+
+DEPTH_PALETTE     = 1 << 5
+DEPTH_RLE         = 1 << 6
+DEPTH_TRANSPARENT = 1 << 7
+
+# ------------------------------------------------------------------------------
+# PNG decoding
+# ------------------------------------------------------------------------------
+
+def paeth(a, b, c):
+
+    p = a + b - c
+    pa, pb, pc = abs(p - a), abs(p - b), abs(p - c)
+    if pa <= pb and pa <= pc: return a
+    return b if pb <= pc else c
+
+def read_png(path):
+    """Returns the width, height and RGBA pixels (row after row) of a PNG file."""
+
+    with open(path, 'rb') as f: data = f.read()
+
+    if data[:8] != b'\x89PNG\r\n\x1a\n': sys.exit('%s: not a PNG file' % path)
+
+    pos, idat, plte, trns = 8, b'', None, None
+
+    while pos < len(data):
+        length, kind = struct.unpack('>I4s', data[pos:pos + 8])
+        chunk = data[pos + 8:pos + 8 + length]
+        pos  += 12 + length
+        if   kind == b'IHDR': width, height, depth, ctype, _, _, interlace = struct.unpack('>IIBBBBB', chunk)
+        elif kind == b'PLTE': plte = chunk
+        elif kind == b'tRNS': trns = chunk
+        elif kind == b'IDAT': idat += chunk
+        elif kind == b'IEND': break
+
+    if interlace:                                sys.exit('%s: interlaced images are not supported' % path)
+    if depth == 16 or (depth < 8 and ctype not in (0, 3)): sys.exit('%s: unsupported bit depth' % path)
+
+    channels = { 0: 1, 2: 3, 3: 1, 4: 2, 6: 4 }[ctype]
+    stride   = (width * channels * depth + 7) // 8
+    bpp      = max(1, channels * depth // 8)
+    raw      = zlib.decompress(idat)
+    prev     = bytearray(stride)
+    pixels   = []
+
+    for y in range(height):
+
+        ftype = raw[y * (stride + 1)]
+        line  = bytearray(raw[y * (stride + 1) + 1:(y + 1) * (stride + 1)])
+
+        for i in range(stride):
+            a = line[i - bpp] if i >= bpp else 0
+            b = prev[i]
+            c = prev[i - bpp] if i >= bpp else 0
+            if   ftype == 1: line[i] = (line[i] + a) & 0xff
+            elif ftype == 2: line[i] = (line[i] + b) & 0xff
+            elif ftype == 3: line[i] = (line[i] + ((a + b) >> 1)) & 0xff
+            elif ftype == 4: line[i] = (line[i] + paeth(a, b, c)) & 0xff
+
+        prev = line
+
+        if depth < 8:
+            per_byte = 8 // depth
+            samples  = [line[x // per_byte] >> (8 - depth * (x % per_byte + 1)) & ((1 << depth) - 1) for x in range(width)]
+        else:
+            samples = line
+
+        for x in range(width):
+            s = samples[x * channels:(x + 1) * channels] if depth == 8 else [samples[x]]
+            if ctype == 0:
+                g = s[0] * 255 // ((1 << depth) - 1)
+                pixels.append((g, g, g, 255))
+            elif ctype == 2: pixels.append((s[0], s[1], s[2], 255))
+            elif ctype == 3:
+                i = s[0]
+                a = trns[i] if trns and i < len(trns) else 255
+                pixels.append((plte[3 * i], plte[3 * i + 1], plte[3 * i + 2], a))
+            elif ctype == 4: pixels.append((s[0], s[0], s[0], s[1]))
+            else:            pixels.append(tuple(s))
+
+    return width, height, pixels
+
+# ------------------------------------------------------------------------------
+# Encoding
+# ------------------------------------------------------------------------------
+
+def rgb565(r, g, b): return (r & 0xf8) << 8 | (g & 0xfc) << 3 | b >> 3
+
+def pack(values, bpp):
+    """Packs pixels most significant bits first."""
+
+    out = bytearray()
+
+    if bpp == 16:
+        for v in values: out += struct.pack('<H', v)
+    else:
+        acc, bits = 0, 0
+        for v in values:
+            acc, bits = acc << bpp | v, bits + bpp
+            if bits == 8: out.append(acc); acc, bits = 0, 0
+        if bits: out.append(acc << (8 - bits))
+
+    return out
+
+def rle(values, bpp):
+    """Splits the pixels into packets (see src/Asset.h)."""
+
+    out, literal, i, n = bytearray(), [], 0, len(values)
+    worth = 2 if bpp >= 8 else 3 # shortest run that saves space
+
+    def flush():
+        while literal:
+            chunk = literal[:128]; del literal[:128]
+            out.append(len(chunk) - 1); out.extend(pack(chunk, bpp))
+
+    while i < n:
+        run = 1
+        while i + run < n and run < 129 and values[i + run] == values[i]: run += 1
+        if run >= worth:
+            flush()
+            out.append(run + 126)
+            out.extend(struct.pack('<H', values[i]) if bpp == 16 else bytes([values[i]]))
+            i += run
+        else:
+            literal.append(values[i]); i += 1
+
+    flush()
+
+    return out
+
+def spare_color(used):
+    """A color that appears nowhere else, for the transparent pixels."""
+
+    color = 0xf81f # magenta
+    while color in used: color = (color + 1) & 0xffff
+    return color
+
+def encode(width, height, pixels, mono, threshold, opaque, raw):
+
+    if width > 255 or height > 255: sys.exit('images are limited to 255x255 pixels')
+
+    has_alpha = any(p[3] < 128 for p in pixels)
+
+    if mono:
+
+        lum    = lambda p: (299 * p[0] + 587 * p[1] + 114 * p[2]) // 1000
+        values = [1 if p[3] >= 128 and lum(p) >= threshold else 0 for p in pixels]
+        bpp, palette, param = 1, [], (0, 0)
+        transparent = not opaque
+
+    else:
+
+        colors   = [rgb565(*p[:3]) if p[3] >= 128 else None for p in pixels]
+        counts   = collections.Counter(c for c in colors if c is not None)
+        distinct = [c for c, _ in counts.most_common()]
+        transparent = has_alpha
+
+        if len(distinct) + transparent <= 256:
+            palette = distinct[:]
+            if transparent: palette.append(spare_color(distinct))
+            index   = { c: i for i, c in enumerate(palette) }
+            values  = [index[c] if c is not None else len(palette) - 1 for c in colors]
+            bpp     = next(b for b in (1, 2, 4, 8) if len(palette) <= 1 << b)
+            param   = (len(palette) - 1, len(palette) - 1 if transparent else 0)
+        else:
+            key     = spare_color(set(distinct))
+            values  = [c if c is not None else key for c in colors]
+            bpp, palette, param = 16, [], (key & 0xff, key >> 8)
+
+    plain  = pack(values, bpp)
+    packed = rle(values, bpp)
+    use_rle = not raw and len(packed) < len(plain)
+
+    fmt = bpp | (DEPTH_PALETTE if palette else 0) | (DEPTH_RLE if use_rle else 0) | (DEPTH_TRANSPARENT if transparent else 0)
+
+    blob = bytearray([fmt, width, height, param[0], param[1]])
+    for c in palette: blob += struct.pack('<H', c)
+    blob += packed if use_rle else plain
+
+    return blob, bpp, len(palette), use_rle
+
+# ------------------------------------------------------------------------------
+# Output
+# ------------------------------------------------------------------------------
+
+def main():
+
+    parser = argparse.ArgumentParser(description='Converts a PNG image into a compressed ESPboy asset.')
+    parser.add_argument('png', help='PNG file to convert')
+    parser.add_argument('-o', '--output', help='header file to write (standard output by default)')
+    parser.add_argument('-n', '--name', help='name of the array (derived from the file name by default)')
+    parser.add_argument('--mono', action='store_true', help='convert to a monochromatic bitmap')
+    parser.add_argument('--threshold', type=int, default=128, help='luminance of the lit pixels of a bitmap (128 by default)')
+    parser.add_argument('--opaque', action='store_true', help='draw the unlit pixels of a bitmap in black')
+    parser.add_argument('--raw', action='store_true', help='do not compress the pixels')
+    args = parser.parse_args()
+
+    width, height, pixels = read_png(args.png)
+    blob, bpp, colors, use_rle = encode(width, height, pixels, args.mono, args.threshold, args.opaque, args.raw)
+
+    name = args.name or re.sub(r'\W', '_', os.path.splitext(os.path.basename(args.png))[0]).upper()
+    full = (width + 7) // 8 * height if args.mono else width * height * 2
+
+    lines = [
+        'static uint8_t const constexpr %s[] PROGMEM = {' % name,
+        '',
+        '    // %s: %dx%d, %d bpp%s%s' % (os.path.basename(args.png), width, height, bpp,
+            ', %d colors' % colors if colors else '', ', RLE' if use_rle else ''),
+        '    // %d bytes (%d%% of the uncompressed %s)' % (len(blob), round(100 * len(blob) / full),
+            'bitmap' if args.mono else 'colormap'),
+        ''
+    ]
+
+    for i in range(0, len(blob), 16):
+        lines.append('    ' + ', '.join('0x%02x' % b for b in blob[i:i + 16]) + (',' if i + 16 < len(blob) else ''))
+
+    lines += ['', '};', '']
+
+    text = '\n'.join(lines)
+
+    if args.output:
+        with open(args.output, 'w') as f: f.write(text)
+    else:
+        sys.stdout.write(text)
+
+if __name__ == '__main__':
+    main()
@@ -0,0 +1,164 @@
+/**
+ * ----------------------------------------------------------------------------
+ * @file   Asset.cpp
+ * @author Stéphane Calderoni (https://github.com/m1cr0lab)
+ * @brief  Compressed images stored in flash memory
+ * ----------------------------------------------------------------------------
+ */
+
+#include "Asset.h"
+
+// a palette starts at an odd address, where pgm_read_word() can't be used
+static uint16_t readWord(uint8_t const * const p) { return pgm_read_byte(p) | pgm_read_byte(p + 1) << 8; }
+
+uint8_t  Asset::width()       const { return _byte(1); }
+uint8_t  Asset::height()      const { return _byte(2); }
+uint8_t  Asset::bpp()         const { return _byte(0) & _DEPTH; }
+uint16_t Asset::colors()      const { return _byte(0) & _PALETTE ? _byte(3) + 1 : 0; }
+bool     Asset::compressed()  const { return _byte(0) & _RLE; }
+bool     Asset::transparent() const { return _byte(0) & _TRANSPARENT; }
+
+uint16_t Asset::size() const {
+
+    uint16_t const header = _HEADER_SIZE + (colors() << 1);
+    uint32_t const pixels = width() * height();
+    uint8_t  const depth  = bpp();
+
+    if (!compressed()) return header + (pixels * depth + 7) / 8;
+
+    uint8_t const *p = _data + header;
+
+    for (uint32_t n = 0; n < pixels;) {
+        uint8_t const packet = pgm_read_byte(p++);
+        if (packet & 0x80) { n += packet - 126; p += depth == 16 ? 2 : 1; }
+        else               { n += packet + 1;   p += ((packet + 1) * depth + 7) / 8; }
+    }
+
+    return p - _data;
+
+}
+
+AssetReader::AssetReader(Asset const &asset) : _asset(asset) { rewind(); }
+
+void AssetReader::rewind() {
+
+    uint8_t const format = _asset._byte(0);
+
+    _bpp     = format & Asset::_DEPTH;
+    _rle     = format & Asset::_RLE;
+    _palette = format & Asset::_PALETTE ? _asset._data + Asset::_HEADER_SIZE : nullptr;
+    _src     = _asset._data + Asset::_HEADER_SIZE + (_asset.colors() << 1);
+    _left    = 0;
+    _bits    = 0;
+
+    if (!(format & Asset::_TRANSPARENT)) _key = 0;
+    else if (_palette)                   _key = hal::displayOrder(readWord(_palette + (_asset._byte(4) << 1)));
+    else if (_bpp == 16)                 _key = hal::displayOrder(readWord(_asset._data + 3));
+    else                                 _key = 0; // depends on the drawing color
+
+}
+
+void AssetReader::_nextPacket() {
+
+    if (!_rle) { _left = 0xff; _repeat = false; return; }
+
+    uint8_t const packet = pgm_read_byte(_src++);
+
+    if (packet & 0x80) {
+        _repeat = true;
+        _left   = packet - 126;
+        _value  = _bpp == 16 ? readWord(_src) : pgm_read_byte(_src);
+        _src   += _bpp == 16 ? 2 : 1;
+    } else {
+        _repeat = false;
+        _left   = packet + 1;
+        _bits   = 0;
+    }
+
+}
+
+uint16_t AssetReader::_nextPixel() {
+
+    if (_bpp == 16) { uint16_t const p = readWord(_src); _src += 2; return p; }
+    if (_bpp == 8)  return pgm_read_byte(_src++);
+
+    if (!_bits) { _byte = pgm_read_byte(_src++); _bits = 8; }
+    _bits -= _bpp;
+
+    return _byte >> _bits & ((1 << _bpp) - 1);
+
+}
+
+uint16_t AssetReader::_color(uint16_t const pixel, uint16_t const color) const {
+
+    if (_palette)   return hal::displayOrder(readWord(_palette + (pixel << 1)));
+    if (_bpp == 16) return hal::displayOrder(pixel);
+
+    return pixel ? hal::displayOrder(color) : key(color);
+
+}
+
+uint16_t AssetReader::key(uint16_t const color) const {
+
+    return _palette || _bpp == 16 || !_asset.transparent() ? _key : hal::displayOrder((uint16_t)~color);
+
+}
+
+void AssetReader::read(uint16_t * const row, uint16_t const color) {
+
+    uint8_t const w = _asset.width();
+
+    for (uint8_t x = 0; x < w;) {
+
+        if (!_left) _nextPacket();
+
+        uint8_t n = _left < w - x ? _left : w - x;
+        _left -= n;
+
+        if (_repeat) {
+            uint16_t const c = _color(_value, color);
+            while (n--) row[x++] = c;
+        } else {
+            while (n--) row[x++] = _color(_nextPixel(), color);
+        }
+
+    }
+
+}
+
+void AssetReader::skip(uint16_t const rows) {
+
+    for (uint32_t left = rows * _asset.width(); left;) {
+
+        if (!_left) _nextPacket();
+
+        uint8_t n = _left < left ? _left : left;
+        _left -= n;
+        left  -= n;
+
+        if (!_repeat) while (n--) _nextPixel();
+
+    }
+
+}
+
+/*
+ * ----------------------------------------------------------------------------
+ * ESPboy Library
+ * ----------------------------------------------------------------------------
+ * Copyright (c) 2021-2022 Stéphane Calderoni (https://github.com/m1cr0lab)
+ * 
+ * This program is free software: you can redistribute it and/or modify
+ * it under the terms of the GNU General Public License as published by
+ * the Free Software Foundation, either version 3 of the License, or
+ * (at your option) any later version.
+ * 
+ * This program is distributed in the hope that it will be useful,
+ * but WITHOUT ANY WARRANTY; without even the implied warranty of
+ * MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE. See the
+ * GNU General Public License for more details.
+ * 
+ * You should have received a copy of the GNU General Public License
+ * along with this program. If not, see <https://www.gnu.org/licenses/>.
+ * ----------------------------------------------------------------------------
+ */
\ No newline at end of file
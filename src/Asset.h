@@ -0,0 +1,209 @@
+/**
+ * ----------------------------------------------------------------------------
+ * @file   Asset.h
+ * @author Stéphane Calderoni (https://github.com/m1cr0lab)
+ * @brief  Compressed images stored in flash memory
+ * ----------------------------------------------------------------------------
+ */
+
+#pragma once
+
+#include <Arduino.h>
+#include "HAL.h"
+
+/**
+ * @brief A compressed image (logo, bitmap or colormap) stored in flash memory.
+ * 
+ * @details Assets are generated offline from PNG files by the converter of
+ *          extras/tools, which writes them as byte arrays in a C++ header:
+ * 
+ *          byte 0     format: bits 0-4 hold the depth (1, 2, 4, 8 or 16 bits
+ *                     per pixel), bit 5 tells if a palette follows the header,
+ *                     bit 6 if the pixels are run-length encoded, and bit 7
+ *                     if the image has transparent pixels
+ *          byte 1     width
+ *          byte 2     height
+ *          byte 3-4   with a palette: number of colors - 1, transparent index
+ *                     at 16 bits per pixel: transparent RGB565 color
+ *          palette    RGB565 colors (little-endian)
+ *          pixels     row after row, packed most significant bits first
+ * 
+ *          Without a palette, a 1-bit image is monochromatic: its pixels
+ *          are drawn with the color given to draw() and the zeros are either
+ *          skipped, like drawBitmap() does, or drawn in black.
+ * 
+ *          Run-length encoded pixels are split into packets which may span
+ *          several rows. A header byte n < 128 introduces n + 1 literal
+ *          pixels, packed from the next byte boundary on, and n >= 128
+ *          repeats n - 126 times the pixel held by the next byte (or the
+ *          next 2 bytes at 16 bits per pixel).
+ * 
+ *          The images are decoded row by row straight into the display or
+ *          a sprite (or a strip of the StripRenderer), so that drawing them
+ *          takes no more RAM than a single row of pixels.
+ */
+class Asset {
+
+    private:
+
+        static uint8_t constexpr _DEPTH       = 0x1f;
+        static uint8_t constexpr _PALETTE     = 1 << 5;
+        static uint8_t constexpr _RLE         = 1 << 6;
+        static uint8_t constexpr _TRANSPARENT = 1 << 7;
+        static uint8_t constexpr _HEADER_SIZE = 5;
+
+        uint8_t const *_data;
+
+        uint8_t _byte(uint8_t const offset) const { return pgm_read_byte(_data + offset); }
+
+        friend class AssetReader;
+
+    public:
+
+        /**
+         * @param data Asset stored in flash memory.
+         */
+        explicit constexpr Asset(uint8_t const *data) : _data(data) {}
+
+        uint8_t const *data() const { return _data; }
+
+        uint8_t width()  const;
+        uint8_t height() const;
+
+        /**
+         * @brief Number of bits per pixel.
+         */
+        uint8_t bpp() const;
+
+        /**
+         * @brief Number of colors of the palette (0 if the asset has no palette).
+         */
+        uint16_t colors() const;
+
+        bool compressed()  const;
+        bool transparent() const;
+
+        /**
+         * @brief Size of the asset in flash memory, in bytes.
+         */
+        uint16_t size() const;
+
+        /**
+         * @brief Draws the asset into the display or a sprite.
+         * 
+         * @param canvas Drawing surface (espboy.tft, a sprite...).
+         * @param x      Abscissa of the top left corner.
+         * @param y      Ordinate of the top left corner.
+         * @param color  RGB565 color of a monochromatic asset.
+         * 
+         * @details The rows above the canvas are decoded without being drawn,
+         *          and the decoding stops at the bottom edge of the canvas.
+         */
+        template <typename Canvas>
+        void draw(Canvas &canvas, int16_t const x, int16_t const y, uint16_t const color = 0xffff) const;
+
+};
+
+/**
+ * @brief This class decodes an asset row by row.
+ */
+class AssetReader {
+
+    private:
+
+        Asset          _asset;
+        uint8_t const *_src;     // next byte of the pixel stream
+        uint8_t const *_palette;
+        uint8_t        _bpp;
+        bool           _rle;
+        uint16_t       _key;     // transparent color
+
+        uint8_t  _left;          // pixels left in the current packet
+        bool     _repeat;
+        uint16_t _value;         // repeated pixel
+        uint8_t  _byte;          // byte the literal pixels are taken from
+        uint8_t  _bits;          // bits left in _byte
+
+        void     _nextPacket();
+        uint16_t _nextPixel();
+        uint16_t _color(uint16_t const pixel, uint16_t const color) const;
+
+    public:
+
+        /**
+         * @param asset Asset to decode, from its first row.
+         */
+        AssetReader(Asset const &asset);
+
+        /**
+         * @brief Starts again from the first row.
+         */
+        void rewind();
+
+        /**
+         * @brief Decodes the next row.
+         * 
+         * @param row   Buffer receiving width() pixels, in the layout expected by pushImage().
+         * @param color RGB565 color of a monochromatic asset.
+         */
+        void read(uint16_t * const row, uint16_t const color = 0xffff);
+
+        /**
+         * @brief Skips rows without converting their pixels.
+         */
+        void skip(uint16_t const rows);
+
+        /**
+         * @brief Color of the transparent pixels, in the layout of the decoded rows.
+         * 
+         * @param color RGB565 color of a monochromatic asset.
+         */
+        uint16_t key(uint16_t const color = 0xffff) const;
+
+};
+
+template <typename Canvas>
+void Asset::draw(Canvas &canvas, int16_t const x, int16_t const y, uint16_t const color) const {
+
+    uint8_t const w = width();
+    int16_t const h = height();
+    int16_t const top    = y < 0 ? -y : 0;
+    int16_t const bottom = y + h > canvas.height() ? canvas.height() - y : h;
+
+    if (top >= bottom || x >= canvas.width() || x + w <= 0) return;
+
+    AssetReader reader(*this);
+    uint16_t    row[w];
+    uint16_t const key = reader.key(color);
+    bool     const keyed = transparent();
+
+    reader.skip(top);
+
+    for (int16_t j = top; j < bottom; ++j) {
+        reader.read(row, color);
+        if (keyed) canvas.pushImage(x, y + j, w, 1, row, key);
+        else       canvas.pushImage(x, y + j, w, 1, row);
+    }
+
+}
+
+/*
+ * ----------------------------------------------------------------------------
+ * ESPboy Library
+ * ----------------------------------------------------------------------------
+ * Copyright (c) 2021-2022 Stéphane Calderoni (https://github.com/m1cr0lab)
+ * 
+ * This program is free software: you can redistribute it and/or modify
+ * it under the terms of the GNU General Public License as published by
+ * the Free Software Foundation, either version 3 of the License, or
+ * (at your option) any later version.
+ * 
+ * This program is distributed in the hope that it will be useful,
+ * but WITHOUT ANY WARRANTY; without even the implied warranty of
+ * MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE. See the
+ * GNU General Public License for more details.
+ * 
+ * You should have received a copy of the GNU General Public License
+ * along with this program. If not, see <https://www.gnu.org/licenses/>.
+ * ----------------------------------------------------------------------------
+ */
\ No newline at end of file
@@ -0,0 +1,108 @@
+/**
+ * ----------------------------------------------------------------------------
+ * @file   Backlight.cpp
+ * @author Stéphane Calderoni (https://github.com/m1cr0lab)
+ * @brief  Backlight controller
+ * ----------------------------------------------------------------------------
+ */
+
+#include "Backlight.h"
+
+constexpr Backlight::_Curve Backlight::_CURVE PROGMEM;
+
+void Backlight::begin(hal::Dac &dac) {
+
+    _dac     = &dac;
+    _written = _UNKNOWN;
+    _level   = 0;
+    _fading  = false;
+
+}
+
+void Backlight::update() {
+
+    if (!_fading) return;
+
+    uint32_t const elapsed = millis() - _start_ms;
+
+    if (elapsed >= _duration_ms) {
+        _fading = false;
+        _apply(_to);
+        return;
+    }
+
+    int16_t const d = _to - _from;
+    uint8_t const e = Ease::apply(_easing, (elapsed << 8) / _duration_ms);
+
+    _apply(_from + (d * e >> 8));
+
+}
+
+void Backlight::set(uint8_t const level) {
+
+    _fading = false;
+    _apply(level);
+
+}
+
+void Backlight::fade(uint8_t const level, uint16_t const duration_ms, Easing const easing) {
+
+    _from        = _level;
+    _to          = level;
+    _easing      = easing;
+    _duration_ms = duration_ms;
+    _start_ms    = millis();
+    _fading      = true;
+
+    update();
+
+}
+
+void Backlight::fadeIn(uint16_t const duration_ms)  { fade(0xff, duration_ms); }
+void Backlight::fadeOut(uint16_t const duration_ms) { fade(0x00, duration_ms); }
+
+bool    Backlight::fading() const { return _fading; }
+uint8_t Backlight::level()  const { return _level;  }
+
+void Backlight::write(uint16_t const value) {
+
+    _fading = false;
+
+    if (value == _written) return;
+
+    _dac->fastWrite(_written = value);
+
+}
+
+void Backlight::_apply(uint8_t const level) {
+
+    _level = level;
+
+    uint16_t const value = pgm_read_word(&_CURVE.dac[level]);
+
+    if (value == _written) return;
+
+    _dac->fastWrite(_written = value);
+
+}
+
+/*
+ * ----------------------------------------------------------------------------
+ * ESPboy Library
+ * ----------------------------------------------------------------------------
+ * Copyright (c) 2021-2022 Stéphane Calderoni (https://github.com/m1cr0lab)
+ * 
+ * This program is free software: you can redistribute it and/or modify
+ * it under the terms of the GNU General Public License as published by
+ * the Free Software Foundation, either version 3 of the License, or
+ * (at your option) any later version.
+ * 
+ * This program is distributed in the hope that it will be useful,
+ * but WITHOUT ANY WARRANTY; without even the implied warranty of
+ * MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE. See the
+ * GNU General Public License for more details.
+ * 
+ * You should have received a copy of the GNU General Public License
+ * along with this program. If not, see <https://www.gnu.org/licenses/>.
+ * ----------------------------------------------------------------------------
+ */
\ No newline at end of file
@@ -0,0 +1,153 @@
+/**
+ * ----------------------------------------------------------------------------
+ * @file   Backlight.h
+ * @author Stéphane Calderoni (https://github.com/m1cr0lab)
+ * @brief  Backlight controller
+ * ----------------------------------------------------------------------------
+ */
+
+#pragma once
+
+#include <Arduino.h>
+#include "HAL.h"
+#include "Easing.h"
+
+/**
+ * @brief This class drives the TFT backlight through the MCP4725 DAC.
+ * 
+ * @details The brightness is expressed on a perceptual scale ranging from
+ *          0 (turned off) to 255 (fully enlightened), converted into DAC
+ *          values along a gamma curve computed at compile time. Fades are
+ *          played in the background by update(), and the DAC is only written
+ *          (with the 3-byte fast mode command) when its value actually changes.
+ */
+class Backlight {
+
+    private:
+
+        static uint16_t constexpr _UNKNOWN = 0xffff; // never matches a 12-bit DAC value
+
+        /**
+         * @brief DAC value of each brightness level (gamma 2.2).
+         */
+        struct _Curve {
+
+            uint16_t dac[256] {};
+
+            constexpr _Curve() {
+
+                dac[0x00] = 0;
+                dac[0xff] = 4095;
+
+                // x^2.2 is approximated by (4x^2 + x^3) / 5
+                for (uint16_t l = 1; l < 0xff; ++l) {
+                    uint64_t const g = 4 * l * l * 0xff + l * l * l;
+                    dac[l] = DAC_MIN + (DAC_MAX - DAC_MIN) * g / (5ULL * 0xff * 0xff * 0xff);
+                }
+
+            }
+
+        };
+
+        static _Curve const _CURVE;
+
+        hal::Dac *_dac;
+        uint16_t  _written; // last value written to the DAC
+
+        uint8_t  _level;
+        uint8_t  _from;
+        uint8_t  _to;
+        Easing   _easing;
+        uint16_t _duration_ms;
+        uint32_t _start_ms;
+        bool     _fading;
+
+        void _apply(uint8_t const level);
+
+    public:
+
+        static uint16_t constexpr DAC_MIN = 650;  // the backlight is off below
+        static uint16_t constexpr DAC_MAX = 1000; // and at full power above
+        static uint16_t constexpr FADE_MS = 800;  // default fade duration
+
+        /**
+         * @brief Initializes the backlight controller.
+         * 
+         * @param dac Reference to the MCP4725 controller owned by the espboy instance.
+         */
+        void begin(hal::Dac &dac);
+
+        /**
+         * @brief Plays the current fade, if any.
+         */
+        void update();
+
+        /**
+         * @brief Sets the brightness at once, cancelling the current fade.
+         * 
+         * @param level Brightness ranging from 0 (turned off) to 255 (fully enlightened).
+         */
+        void set(uint8_t const level);
+
+        /**
+         * @brief Fades the brightness from its current level to a new one.
+         * 
+         * @param level       Final brightness ranging from 0 to 255.
+         * @param duration_ms Duration of the fade in milliseconds.
+         * @param easing      Easing curve of the fade.
+         */
+        void fade(uint8_t const level, uint16_t const duration_ms = FADE_MS, Easing const easing = Easing::EASE_IN_OUT);
+
+        /**
+         * @brief Fades the backlight up to full brightness.
+         * 
+         * @param duration_ms Duration of the fade in milliseconds.
+         */
+        void fadeIn(uint16_t const duration_ms = FADE_MS);
+
+        /**
+         * @brief Fades the backlight down until it is turned off.
+         * 
+         * @param duration_ms Duration of the fade in milliseconds.
+         */
+        void fadeOut(uint16_t const duration_ms = FADE_MS);
+
+        /**
+         * @brief Whether a fade is being played.
+         */
+        bool fading() const;
+
+        /**
+         * @brief Current brightness level (0 to 255).
+         */
+        uint8_t level() const;
+
+        /**
+         * @brief Writes a raw value to the DAC, cancelling the current fade.
+         * 
+         * @param value DAC value ranging from 0 to 4095.
+         */
+        void write(uint16_t const value);
+
+};
+
+/*
+ * ----------------------------------------------------------------------------
+ * ESPboy Library
+ * ----------------------------------------------------------------------------
+ * Copyright (c) 2021-2022 Stéphane Calderoni (https://github.com/m1cr0lab)
+ * 
+ * This program is free software: you can redistribute it and/or modify
+ * it under the terms of the GNU General Public License as published by
+ * the Free Software Foundation, either version 3 of the License, or
+ * (at your option) any later version.
+ * 
+ * This program is distributed in the hope that it will be useful,
+ * but WITHOUT ANY WARRANTY; without even the implied warranty of
+ * MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE. See the
+ * GNU General Public License for more details.
+ * 
+ * You should have received a copy of the GNU General Public License
+ * along with this program. If not, see <https://www.gnu.org/licenses/>.
+ * ----------------------------------------------------------------------------
+ */
\ No newline at end of file
@@ -8,53 +8,92 @@
 
 #include "Button.h"
 
-void Button::read(uint8_t const input) {
-
-    for (uint8_t i = 0; i < 8; ++i) {
-
-        uint8_t const reading = input & (1 << i);
-
-        /**
-         * @note Software debouncing algorithm (Kennet A. Kuhn)
-         * @see  https://www.kennethkuhn.com/electronics/debounce.c
-         */
-             if (!reading) { if (_integrator[i]) _integrator[i]--; }
-        else if (_integrator[i] < _DEBOUNCING_THRESHOLD) _integrator[i]++;
-        uint8_t const output = !_integrator[i] ? 0 : (_integrator[i] == _DEBOUNCING_THRESHOLD ? 1 : 0);
-
-        switch (_state[i]) {
-
-            case _State::FREE:
-                if (output) _state[i] = _State::PRESSED;
-                break;
-            
-            case _State::PRESSED:
-                if (output) {
-                    _state[i] = _State::HELD;
-                    _held_start_ms[i] = millis();
-                } else _state[i] = _State::RELEASED;
-                break;
-            
-            case _State::HELD:
-                if (!output) _state[i] = _State::RELEASED;
-                break;
-            
-            case _State::RELEASED:
-                _state[i] = _State::FREE;
-                break;
-            
-        }
+void Button::read(uint8_t const input) { read(input, micros()); }
+
+void Button::read(uint8_t const input, uint32_t const us) {
+
+    sample(input, us);
+
+    // FREE -> PRESSED -> HELD -> RELEASED -> FREE
+    //            └──────────────────┘
+    uint8_t const free = ~(_pressed | _held | _released);
+    uint8_t const down = _pressed | _held;
+
+    _pressed  = free & _output;
+    _held     = down & _output;
+    _released = down & ~_output;
+
+}
+
+void Button::sample(uint8_t const input, uint32_t const us) {
 
+    /**
+     * @note Software debouncing algorithm (Kennet A. Kuhn), computed for the
+     *       8 buttons in parallel with 2-bit vertical counters: each integrator
+     *       counts up while its button reads 1, down while it reads 0, and
+     *       saturates at 0 and _DEBOUNCING_THRESHOLD. The debounced output of a
+     *       button is 1 only when its integrator reaches the threshold.
+     * @see  https://www.kennethkuhn.com/electronics/debounce.c
+     */
+    uint8_t const saturated = (input & _count_hi & _count_lo) | (~input & ~_count_hi & ~_count_lo);
+    uint8_t const counting  = ~saturated;
+
+    _count_hi ^= counting & ~(_count_lo ^ input);
+    _count_lo ^= counting;
+
+    uint8_t changes = _output ^ (_count_hi & _count_lo);
+    if (!changes) return;
+
+    _output ^= changes;
+
+    uint32_t const ms = millis() - (micros() - us) / 1000;
+
+    for (uint8_t i = 0; changes; ++i, changes >>= 1) {
+        if (changes & 1) {
+            bool const down = _output & (1 << i);
+            if (down) _held_start_ms[i] = ms;
+            if (_events_enabled) _push(i, down, us);
+        }
     }
 
 }
 
-bool Button::pressed(uint8_t const button)  const { return _state[button & 0x7] == _State::PRESSED;  }
-bool Button::released(uint8_t const button) const { return _state[button & 0x7] == _State::RELEASED; }
+void Button::_push(uint8_t const button, bool const pressed, uint32_t const us) {
+
+    if (_event_count == _EVENT_QUEUE_SIZE) { _events_lost++; return; }
+
+    _events[(_event_head + _event_count++) % _EVENT_QUEUE_SIZE] = { us, button, pressed };
+
+}
+
+void Button::enableEvents(bool const enabled) {
+
+    _events_enabled = enabled;
+    _event_head = _event_count = _events_lost = 0;
+
+}
+
+bool Button::nextEvent(ButtonEvent &event) {
+
+    if (!_event_count) return false;
+
+    event = _events[_event_head];
+    _event_head = (_event_head + 1) % _EVENT_QUEUE_SIZE;
+    _event_count--;
+
+    return true;
+
+}
+
+uint8_t  Button::pendingEvents() const { return _event_count; }
+uint16_t Button::lostEvents()    const { return _events_lost; }
+
+bool Button::pressed(uint8_t const button)  const { return _pressed  & (1 << (button & 0x7)); }
+bool Button::released(uint8_t const button) const { return _released & (1 << (button & 0x7)); }
 
 bool Button::held(uint8_t const button, uint32_t const delay_ms) const {
 
-    return _state[button & 0x7] == _State::HELD && (
+    return (_held & (1 << (button & 0x7))) && (
         delay_ms
         ? millis() - _held_start_ms[button & 0x7] >= delay_ms
         : true
@@ -62,6 +101,10 @@ bool Button::held(uint8_t const button, uint32_t const delay_ms) const {
 
 }
 
+uint8_t Button::pressedMask()  const { return _pressed;  }
+uint8_t Button::releasedMask() const { return _released; }
+uint8_t Button::heldMask()     const { return _held;     }
+
 /*
  * ----------------------------------------------------------------------------
  * ESPboy Library
@@ -10,6 +10,17 @@
 
 #include <Arduino.h>
 
+/**
+ * @brief A push button state change, as recorded in the event queue of the Button controller.
+ */
+struct ButtonEvent {
+
+    uint32_t us;      // timestamp in microseconds
+    uint8_t  button;  // Button::LEFT, Button::UP, ..., Button::TOP_RIGHT
+    bool     pressed; // true when the button went down, false when it went up
+
+};
+
 /**
  * @brief This class provides a controller to check the state
  *        of the various buttons of the ESPboy handheld.
@@ -20,11 +31,28 @@ class Button {
 
         static uint8_t constexpr _DEBOUNCING_THRESHOLD = 3;
 
-        enum class _State : uint8_t { FREE, PRESSED, HELD, RELEASED };
+        static_assert(_DEBOUNCING_THRESHOLD == 3, "the vertical counters of the debouncer are 2-bit wide");
+
+        static uint8_t constexpr _EVENT_QUEUE_SIZE = 16;
 
-        _State   _state[8];
-        uint32_t _held_start_ms[8];
-        uint8_t  _integrator[8];
+        // Each button owns one bit of every mask below: the states of the
+        // 8 buttons are thus updated all at once with bitwise operations.
+
+        uint8_t  _count_lo = 0; // 2-bit vertical counters of the debouncer
+        uint8_t  _count_hi = 0; // (one per button, saturating at the threshold)
+        uint8_t  _output   = 0; // debounced button states
+        uint8_t  _pressed  = 0;
+        uint8_t  _held     = 0;
+        uint8_t  _released = 0;
+        uint32_t _held_start_ms[8] {};
+
+        ButtonEvent _events[_EVENT_QUEUE_SIZE];
+        uint8_t     _event_head     = 0;
+        uint8_t     _event_count    = 0;
+        uint16_t    _events_lost    = 0;
+        bool        _events_enabled = false;
+
+        void _push(uint8_t const button, bool const pressed, uint32_t const us);
 
     public:
 
@@ -46,6 +74,57 @@ class Button {
          */
         void read(uint8_t const input);
 
+        /**
+         * @brief Bulk read all push button states.
+         * 
+         * @param input Current pin states of MCP23017 Port A as a uint8_t.
+         * @param us    Time in microseconds at which the input was captured.
+         * 
+         * @details The state of each button is filtered by a software debouncing algorithm.
+         */
+        void read(uint8_t const input, uint32_t const us);
+
+        /**
+         * @brief Feeds the debouncer with an intermediate sample, between two frames.
+         * 
+         * @param input Current pin states of MCP23017 Port A as a uint8_t.
+         * @param us    Time in microseconds at which the input was captured.
+         * 
+         * @details Button state changes are timestamped and pushed into the event
+         *          queue (when enabled), but pressed(), held() and released() keep
+         *          reflecting the state of the last read() until the next one.
+         */
+        void sample(uint8_t const input, uint32_t const us);
+
+        /**
+         * @brief Enables or disables the event queue.
+         * 
+         * @details When enabled, every debounced state change is recorded with its
+         *          timestamp, so that taps shorter than a frame, or several taps
+         *          within a single frame, are never lost. The queue holds up to
+         *          16 events and must be drained with nextEvent() at each frame.
+         */
+        void enableEvents(bool const enabled = true);
+
+        /**
+         * @brief Pops the oldest event from the queue.
+         * 
+         * @param event Receives the event.
+         * 
+         * @return true if an event has been popped, false if the queue is empty.
+         */
+        bool nextEvent(ButtonEvent &event);
+
+        /**
+         * @brief Number of events waiting in the queue.
+         */
+        uint8_t pendingEvents() const;
+
+        /**
+         * @brief Number of events discarded because the queue was full.
+         */
+        uint16_t lostEvents() const;
+
         /**
          * @brief Checks if a button has just been pressed.
          * 
@@ -84,6 +163,30 @@ class Button {
          *         delay_ms if specified, false otherwise.
          */
         bool held(uint8_t const button, uint32_t const delay_ms = 0) const;
+
+        /**
+         * @brief Bulk check of the buttons that have just been pressed.
+         * 
+         * @return A bitmask where bit i is set if button i has just been pressed
+         *         (can be tested against the PAD_* constants).
+         */
+        uint8_t pressedMask() const;
+
+        /**
+         * @brief Bulk check of the buttons that have just been released.
+         * 
+         * @return A bitmask where bit i is set if button i has just been released
+         *         (can be tested against the PAD_* constants).
+         */
+        uint8_t releasedMask() const;
+
+        /**
+         * @brief Bulk check of the buttons that are held down.
+         * 
+         * @return A bitmask where bit i is set if button i is held down
+         *         (can be tested against the PAD_* constants).
+         */
+        uint8_t heldMask() const;
     
 };
 
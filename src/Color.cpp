@@ -8,61 +8,28 @@
 
 #include "Color.h"
 
-void Color::_hsv2rgb(uint16_t hue, uint8_t const sat, uint8_t const val, uint8_t *red, uint8_t *green, uint8_t *blue) {
+constexpr Color::_HueWheel Color::_HUE_WHEEL PROGMEM;
+constexpr Color::_Dimmer   Color::_DIMMER    PROGMEM;
 
-    if (!sat) { *red = *green = *blue = val; return; }
+uint32_t Color::hsv2rgbFast(uint16_t const hue, uint8_t const val) {
 
-    hue = (hue << 5) / 45; // converts [0, 359] to [0, 255]
+    uint32_t const c = pgm_read_dword(&_HUE_WHEEL.rgb888[hue]);
+    if (val == 0xff) return c;
 
-    uint8_t const sextant   = hue / 43;
-    uint8_t const remainder = (hue - (sextant * 43)) * 6;
+    uint16_t const v = val + 1;
 
-    uint8_t const p = (val * ~sat) >> 8;
-    uint8_t const q = (val * ~(sat *  remainder) >> 8) >> 8;
-    uint8_t const t = (val * ~(sat * ~remainder) >> 8) >> 8;
-
-    switch (sextant) {
-
-        case 0:  *red = val; *green =   t; *blue =   p; break;
-        case 1:  *red =   q; *green = val; *blue =   p; break;
-        case 2:  *red =   p; *green = val; *blue =   t; break;
-        case 3:  *red =   p; *green =   q; *blue = val; break;
-        case 4:  *red =   t; *green =   p; *blue = val; break;
-        default: *red = val; *green =   p; *blue =   q;
-
-    }
-
-}
-
-uint32_t Color::rgb(uint8_t const red, uint8_t const green, uint8_t const blue) {
-
-    return (red << 16) | (green << 8) | blue;
-
-}
-
-uint16_t Color::rgb565(uint8_t const red, uint8_t const green, uint8_t const blue) {
-
-    return (red >> 3) << 11 | (green >> 2) << 5 | blue >> 3;
+    return ((c >> 16) * v >> 8) << 16 | ((c >> 8 & 0xff) * v >> 8) << 8 | (c & 0xff) * v >> 8;
 
 }
 
-uint32_t Color::hsv2rgb(uint16_t hue, uint8_t const sat, uint8_t const val) {
-
-    uint8_t red, green, blue;
-
-    _hsv2rgb(hue, sat, val, &red, &green, &blue);
-
-    return rgb(red, green, blue);
-
-}
-
-uint16_t Color::hsv2rgb565(uint16_t hue, uint8_t const sat, uint8_t const val) {
-
-    uint8_t red, green, blue;
+uint16_t Color::hsv2rgb565Fast(uint16_t const hue, uint8_t const val) {
 
-    _hsv2rgb(hue, sat, val, &red, &green, &blue);
+    uint16_t const c     = pgm_read_word(&_HUE_WHEEL.rgb565[hue]);
+    uint8_t  const level = val >> 3;
 
-    return rgb565(red, green, blue);
+    return pgm_read_byte(&_DIMMER.c5[level][c >> 11])        << 11 |
+           pgm_read_byte(&_DIMMER.c6[level][c >> 5 & 0x3f]) <<  5 |
+           pgm_read_byte(&_DIMMER.c5[level][c & 0x1f]);
 
 }
 
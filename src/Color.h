@@ -14,10 +14,129 @@ class Color {
 
     private:
 
-        static void _hsv2rgb(uint16_t hue, uint8_t const sat, uint8_t const val, uint8_t *red, uint8_t *green, uint8_t *blue);
+        static constexpr uint32_t _hsv2rgb(uint16_t hue, uint8_t const sat, uint8_t const val) {
+
+            if (!sat) return rgb(val, val, val);
+
+            hue = (hue << 5) / 45; // converts [0, 359] to [0, 255]
+
+            uint8_t const sextant   = hue / 43;
+            uint8_t const remainder = (hue - (sextant * 43)) * 6;
+
+            uint8_t const p = val * (0xff - sat) >> 8;
+            uint8_t const q = val * (0xffff - sat * remainder) >> 16;
+            uint8_t const t = val * (0xffff - sat * (0xff - remainder)) >> 16;
+
+            switch (sextant) {
+
+                case 0:  return rgb(val,   t,   p);
+                case 1:  return rgb(  q, val,   p);
+                case 2:  return rgb(  p, val,   t);
+                case 3:  return rgb(  p,   q, val);
+                case 4:  return rgb(  t,   p, val);
+                default: return rgb(val,   p,   q);
+
+            }
+
+        }
+
+        static constexpr uint32_t _hsl2rgb(uint16_t const hue, uint8_t const sat, uint8_t const lum) {
+
+            // chroma and lightness are expressed in 1/10000
+            uint32_t const c = (100 - (lum < 50 ? 100 - 2 * lum : 2 * lum - 100)) * sat;
+            uint32_t const m = lum * 100 - c / 2;
+            uint16_t const h = hue % 120;
+            uint32_t const x = c * (60 - (h < 60 ? 60 - h : h - 60)) / 60;
+
+            uint8_t const cc = ((c + m) * 0xff + 5000) / 10000;
+            uint8_t const xx = ((x + m) * 0xff + 5000) / 10000;
+            uint8_t const mm = (     m  * 0xff + 5000) / 10000;
+
+            switch (hue / 60) {
+
+                case 0:  return rgb(cc, xx, mm);
+                case 1:  return rgb(xx, cc, mm);
+                case 2:  return rgb(mm, cc, xx);
+                case 3:  return rgb(mm, xx, cc);
+                case 4:  return rgb(xx, mm, cc);
+                default: return rgb(cc, mm, xx);
+
+            }
+
+        }
+
+        /**
+         * @brief Fully saturated and bright colors of the hue wheel, one per degree.
+         */
+        struct _HueWheel {
+
+            uint16_t rgb565[360] {};
+            uint32_t rgb888[360] {};
+
+            constexpr _HueWheel() {
+
+                for (uint16_t hue = 0; hue < 360; ++hue) {
+                    rgb888[hue] = _hsv2rgb(hue, 0xff, 0xff);
+                    rgb565[hue] = rgb888to565(rgb888[hue]);
+                }
+
+            }
+
+        };
+
+        static uint8_t constexpr _LEVELS = 32;
+
+        /**
+         * @brief RGB565 components scaled by 32 brightness levels (level / 31).
+         */
+        struct _Dimmer {
+
+            uint8_t c5[_LEVELS][32] {};
+            uint8_t c6[_LEVELS][64] {};
+
+            constexpr _Dimmer() {
+
+                for (uint8_t level = 0; level < _LEVELS; ++level) {
+                    for (uint8_t c = 0; c < 32; ++c) c5[level][c] = (c * level + 15) / 31;
+                    for (uint8_t c = 0; c < 64; ++c) c6[level][c] = (c * level + 15) / 31;
+                }
+
+            }
+
+        };
+
+        static _HueWheel const _HUE_WHEEL;
+        static _Dimmer   const _DIMMER;
 
     public:
 
+        /**
+         * @brief A palette of 16-bit RGB565 colors built at compile time.
+         * 
+         * @tparam N Number of colors.
+         * 
+         * @details Declare it as a `constexpr` global variable with the `PROGMEM`
+         *          attribute so that it lands directly in flash memory, and read
+         *          its colors with the subscript operator:
+         * 
+         *          auto constexpr TILES PROGMEM = Color::palette(
+         *              Color::hsl2rgb565(34, 18, 76),
+         *              Color::hsl2rgb565(40, 40, 86)
+         *          );
+         * 
+         *          fb.fillRect(x, y, w, h, TILES[i]);
+         */
+        template <uint16_t N>
+        struct Palette {
+
+            uint16_t colors[N];
+
+            static uint16_t constexpr SIZE = N;
+
+            uint16_t operator[](uint16_t const i) const { return pgm_read_word(&colors[i]); }
+
+        };
+
         /**
          * @brief Returns a packed 32-bit RGB888 color from its red, green and blue components.
          * 
@@ -27,7 +146,11 @@ class Color {
          * 
          * @return A 32-bit integer RGB888 color code.
          */
-        static uint32_t rgb(uint8_t const red, uint8_t const green, uint8_t const blue);
+        static constexpr uint32_t rgb(uint8_t const red, uint8_t const green, uint8_t const blue) {
+
+            return (uint32_t)red << 16 | green << 8 | blue;
+
+        }
 
         /**
          * @brief Returns a packed 16-bit RGB565 color from its red, green and blue components.
@@ -38,7 +161,70 @@ class Color {
          * 
          * @return A 16-bit integer RGB565 color code.
          */
-        static uint16_t rgb565(uint8_t const red, uint8_t const green, uint8_t const blue);
+        static constexpr uint16_t rgb565(uint8_t const red, uint8_t const green, uint8_t const blue) {
+
+            return (red >> 3) << 11 | (green >> 2) << 5 | blue >> 3;
+
+        }
+
+        /**
+         * @brief Converts a 32-bit RGB888 color to a 16-bit RGB565 color.
+         * 
+         * @param color A 32-bit integer RGB888 color code.
+         * 
+         * @return A 16-bit integer RGB565 color code.
+         */
+        static constexpr uint16_t rgb888to565(uint32_t const color) {
+
+            return rgb565(color >> 16, color >> 8, color);
+
+        }
+
+        /**
+         * @brief Converts a 16-bit RGB565 color to a 32-bit RGB888 color.
+         * 
+         * @param color A 16-bit integer RGB565 color code.
+         * 
+         * @return A 32-bit integer RGB888 color code.
+         * 
+         * @details The high bits of each component are replicated into its low
+         *          bits, so that white remains white and black remains black.
+         */
+        static constexpr uint32_t rgb565to888(uint16_t const color) {
+
+            uint8_t const r = color >> 11;
+            uint8_t const g = color >> 5 & 0x3f;
+            uint8_t const b = color & 0x1f;
+
+            return rgb(r << 3 | r >> 2, g << 2 | g >> 4, b << 3 | b >> 2);
+
+        }
+
+        /**
+         * @brief Converts a 32-bit RGB888 color to the GRB888 order expected by the NeoPixel LED.
+         * 
+         * @param color A 32-bit integer RGB888 color code.
+         * 
+         * @return A 32-bit integer GRB888 color code.
+         */
+        static constexpr uint32_t rgb2grb(uint32_t const color) {
+
+            return (color >> 8 & 0xff) << 16 | (color >> 16 & 0xff) << 8 | (color & 0xff);
+
+        }
+
+        /**
+         * @brief Converts a 16-bit RGB565 color to the GRB888 order expected by the NeoPixel LED.
+         * 
+         * @param color A 16-bit integer RGB565 color code.
+         * 
+         * @return A 32-bit integer GRB888 color code.
+         */
+        static constexpr uint32_t rgb5652grb(uint16_t const color) {
+
+            return rgb2grb(rgb565to888(color));
+
+        }
 
         /**
          * @brief Returns a packed 32-bit RGB888 color from its hue, saturation and brightness components.
@@ -49,7 +235,11 @@ class Color {
          * 
          * @return A 32-bit integer RGB888 color code.
          */
-        static uint32_t hsv2rgb(uint16_t hue, uint8_t const sat = 0xff, uint8_t const val = 0xff);
+        static constexpr uint32_t hsv2rgb(uint16_t const hue, uint8_t const sat = 0xff, uint8_t const val = 0xff) {
+
+            return _hsv2rgb(hue, sat, val);
+
+        }
 
         /**
          * @brief Returns a packed 16-bit RGB565 color from its hue, saturation and brightness components.
@@ -60,7 +250,113 @@ class Color {
          * 
          * @return A 16-bit integer RGB565 color code.
          */
-        static uint16_t hsv2rgb565(uint16_t hue, uint8_t const sat = 0xff, uint8_t const val = 0xff);
+        static constexpr uint16_t hsv2rgb565(uint16_t const hue, uint8_t const sat = 0xff, uint8_t const val = 0xff) {
+
+            return rgb888to565(_hsv2rgb(hue, sat, val));
+
+        }
+
+        /**
+         * @brief Returns a packed 32-bit RGB888 color from its hue, saturation and lightness components.
+         * 
+         * @param hue Hue ranging from 0 to 359.
+         * @param sat Saturation ranging from 0 to 100 (percent).
+         * @param lum Lightness ranging from 0 to 100 (percent).
+         * 
+         * @return A 32-bit integer RGB888 color code.
+         * 
+         * @details Same notation as the CSS hsl() function, handy to reproduce
+         *          a palette designed in a web browser.
+         */
+        static constexpr uint32_t hsl2rgb(uint16_t const hue, uint8_t const sat, uint8_t const lum) {
+
+            return _hsl2rgb(hue, sat, lum);
+
+        }
+
+        /**
+         * @brief Returns a packed 16-bit RGB565 color from its hue, saturation and lightness components.
+         * 
+         * @param hue Hue ranging from 0 to 359.
+         * @param sat Saturation ranging from 0 to 100 (percent).
+         * @param lum Lightness ranging from 0 to 100 (percent).
+         * 
+         * @return A 16-bit integer RGB565 color code.
+         */
+        static constexpr uint16_t hsl2rgb565(uint16_t const hue, uint8_t const sat, uint8_t const lum) {
+
+            return rgb888to565(_hsl2rgb(hue, sat, lum));
+
+        }
+
+        /**
+         * @brief Builds a palette from a list of RGB565 colors.
+         * 
+         * @param colors 16-bit integer RGB565 color codes.
+         * 
+         * @return A palette holding the given colors, in the same order.
+         */
+        template <typename... T>
+        static constexpr Palette<sizeof...(T)> palette(T const... colors) {
+
+            return {{ static_cast<uint16_t>(colors)... }};
+
+        }
+
+        /**
+         * @brief Builds a palette of N colors from a generator.
+         * 
+         * @tparam N Number of colors.
+         * 
+         * @param generator A constexpr function (or lambda) returning the RGB565
+         *                  color of a given index, from 0 to N - 1.
+         * 
+         * @return A palette holding the generated colors.
+         * 
+         * @details For instance, a rainbow of 16 colors:
+         * 
+         *          auto constexpr RAINBOW PROGMEM = Color::palette<16>(
+         *              [](uint16_t const i) { return Color::hsv2rgb565(i * 360 / 16); }
+         *          );
+         */
+        template <uint16_t N, typename Generator>
+        static constexpr Palette<N> palette(Generator const generator) {
+
+            Palette<N> p {};
+            for (uint16_t i = 0; i < N; ++i) p.colors[i] = generator(i);
+
+            return p;
+
+        }
+
+        /**
+         * @brief Table-driven version of hsv2rgb() for fully saturated colors.
+         * 
+         * @param hue Hue ranging from 0 to 359.
+         * @param val Brightness ranging from 0 to 255.
+         * 
+         * @return A 32-bit integer RGB888 color code.
+         * 
+         * @details The color is read from a hue wheel computed at compile time
+         *          and stored in flash memory (1.4 KB), then scaled by the
+         *          brightness, without any division.
+         */
+        static uint32_t hsv2rgbFast(uint16_t const hue, uint8_t const val = 0xff);
+
+        /**
+         * @brief Table-driven version of hsv2rgb565() for fully saturated colors.
+         * 
+         * @param hue Hue ranging from 0 to 359.
+         * @param val Brightness ranging from 0 to 255, rounded down to 32 levels.
+         * 
+         * @return A 16-bit integer RGB565 color code.
+         * 
+         * @details The color is read from a hue wheel computed at compile time,
+         *          and its components are scaled through a brightness table,
+         *          both stored in flash memory (3.7 KB altogether). Only lookups
+         *          are involved, which suits the hot loops of a game.
+         */
+        static uint16_t hsv2rgb565Fast(uint16_t const hue, uint8_t const val = 0xff);
 
 };
 
@@ -0,0 +1,94 @@
+/**
+ * ----------------------------------------------------------------------------
+ * @file   DoubleBuffer.cpp
+ * @author Stéphane Calderoni (https://github.com/m1cr0lab)
+ * @brief  Double-buffered rendering with background transfer to the display
+ * ----------------------------------------------------------------------------
+ */
+
+#include "DoubleBuffer.h"
+#include "Profiler.h"
+
+DoubleBuffer::DoubleBuffer()
+: _back(0)
+, _height(0)
+, _ready(false)
+, _stall_us(0)
+{}
+
+bool DoubleBuffer::begin(hal::Display &tft, uint8_t const height) {
+
+    end();
+
+    for (uint8_t i = 0; i < 2; ++i) {
+        _buffer[i].setColorDepth(16);
+        if (!_buffer[i].createSprite(WIDTH, height)) { end(); return false; }
+    }
+
+    _blit.begin(tft);
+
+    _back   = 0;
+    _height = height;
+    _ready  = true;
+
+    return true;
+
+}
+
+void DoubleBuffer::end() {
+
+    _blit.finish();
+
+    _buffer[0].deleteSprite();
+    _buffer[1].deleteSprite();
+
+    _height = 0;
+    _ready  = false;
+
+}
+
+bool         DoubleBuffer::ready()     const { return _ready;         }
+uint8_t      DoubleBuffer::height()    const { return _height;        }
+hal::Sprite &DoubleBuffer::canvas()          { return _buffer[_back]; }
+bool         DoubleBuffer::busy()      const { return _blit.busy();   }
+uint32_t     DoubleBuffer::stallTime() const { return _stall_us;      }
+
+void DoubleBuffer::wait() {
+
+    uint32_t const start = micros();
+    _blit.finish();
+    _stall_us = micros() - start;
+
+}
+
+void DoubleBuffer::present(int32_t const y) {
+
+    Profiler::Scope scope(Profiler::FLUSH);
+
+    wait();
+
+    _blit.start((uint16_t const *)_buffer[_back].getBuffer(), 0, y, WIDTH, _height);
+    _back ^= 1;
+
+}
+
+/*
+ * ----------------------------------------------------------------------------
+ * ESPboy Library
+ * ----------------------------------------------------------------------------
+ * Copyright (c) 2021-2022 Stéphane Calderoni (https://github.com/m1cr0lab)
+ * 
+ * This program is free software: you can redistribute it and/or modify
+ * it under the terms of the GNU General Public License as published by
+ * the Free Software Foundation, either version 3 of the License, or
+ * (at your option) any later version.
+ * 
+ * This program is distributed in the hope that it will be useful,
+ * but WITHOUT ANY WARRANTY; without even the implied warranty of
+ * MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE. See the
+ * GNU General Public License for more details.
+ * 
+ * You should have received a copy of the GNU General Public License
+ * along with this program. If not, see <https://www.gnu.org/licenses/>.
+ * ----------------------------------------------------------------------------
+ */
\ No newline at end of file
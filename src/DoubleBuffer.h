@@ -0,0 +1,133 @@
+/**
+ * ----------------------------------------------------------------------------
+ * @file   DoubleBuffer.h
+ * @author Stéphane Calderoni (https://github.com/m1cr0lab)
+ * @brief  Double-buffered rendering with background transfer to the display
+ * ----------------------------------------------------------------------------
+ */
+
+#pragma once
+
+#include "HAL.h"
+
+/**
+ * @brief This class provides two offscreen buffers: the game draws into one
+ *        of them while the other one is being sent to the display in the
+ *        background.
+ * 
+ * @details Sending a full 128x128 frame keeps the SPI bus busy for several
+ *          milliseconds. With a single sprite, pushSprite() blocks the game
+ *          during that time. Here, present() hands the buffer over to a
+ *          background transfer and returns at once, so that the next buffer
+ *          can be computed while the previous one is being displayed.
+ * 
+ *          Two full-height buffers take 64 KB, which exceeds the heap of the
+ *          ESP8266: buffers are 128x64 by default, and a frame is then drawn
+ *          in two bands, each one being presented at its own screen row:
+ * 
+ *              for (uint8_t y = 0; y < 128; y += 64) {
+ *                  hal::Sprite &band = espboy.screen.canvas();
+ *                  ...draw the band, shifted up by y...
+ *                  espboy.screen.present(y);
+ *              }
+ * 
+ *          The last buffer is still being sent when present() returns (see
+ *          hal::AsyncBlit).
+ */
+class DoubleBuffer {
+
+    private:
+
+        hal::AsyncBlit _blit;
+        hal::Sprite    _buffer[2];
+        uint8_t        _back;
+        uint8_t        _height;
+        bool           _ready;
+        uint32_t       _stall_us;
+
+    public:
+
+        static uint8_t constexpr WIDTH = 128;
+
+        DoubleBuffer();
+
+        /**
+         * @brief Allocates both buffers.
+         * 
+         * @param tft    Display controller the buffers are sent to.
+         * @param height Height of the buffers (2 x 16 KB for the default 64 rows).
+         * 
+         * @return true if the allocation has succeeded.
+         */
+        bool begin(hal::Display &tft, uint8_t const height = 64);
+
+        /**
+         * @brief Waits for the pending transfer and releases both buffers.
+         */
+        void end();
+
+        /**
+         * @brief Tells whether the buffers have been allocated.
+         */
+        bool ready() const;
+
+        /**
+         * @brief Height of the buffers.
+         */
+        uint8_t height() const;
+
+        /**
+         * @brief Buffer to draw into.
+         */
+        hal::Sprite &canvas();
+
+        /**
+         * @brief Sends the canvas to the display, at row y, in the background.
+         * 
+         * @details Waits for the completion of the previous transfer, starts the
+         *          new one and swaps the buffers: the next canvas can be drawn
+         *          into as soon as this function returns.
+         */
+        void present(int32_t const y = 0);
+
+        /**
+         * @brief Tells whether a transfer is still in progress.
+         */
+        bool busy() const;
+
+        /**
+         * @brief Waits for the completion of the pending transfer (fence).
+         */
+        void wait();
+
+        /**
+         * @brief Time in microseconds the last present() or wait() spent waiting
+         *        for the previous transfer.
+         * 
+         * @details A non-zero value means that drawing a buffer takes less time
+         *          than sending one: the game is bound by the SPI bus.
+         */
+        uint32_t stallTime() const;
+
+};
+
+/*
+ * ----------------------------------------------------------------------------
+ * ESPboy Library
+ * ----------------------------------------------------------------------------
+ * Copyright (c) 2021-2022 Stéphane Calderoni (https://github.com/m1cr0lab)
+ * 
+ * This program is free software: you can redistribute it and/or modify
+ * it under the terms of the GNU General Public License as published by
+ * the Free Software Foundation, either version 3 of the License, or
+ * (at your option) any later version.
+ * 
+ * This program is distributed in the hope that it will be useful,
+ * but WITHOUT ANY WARRANTY; without even the implied warranty of
+ * MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE. See the
+ * GNU General Public License for more details.
+ * 
+ * You should have received a copy of the GNU General Public License
+ * along with this program. If not, see <https://www.gnu.org/licenses/>.
+ * ----------------------------------------------------------------------------
+ */
\ No newline at end of file
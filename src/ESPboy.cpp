@@ -28,13 +28,8 @@ void ESPboy::begin(char const * const title, uint16 const color) {
 
     _init(); if (_buttons) return;
 
-    _showESPboyLogo(title, color);
-    _fadeInOut(1000);
-
-    tft.setTextColor(TFT_WHITE); // reset default color
-    fadeIn();
-
-    _initialized = true;
+    _logo.width = 0;
+    _boot(title, color);
 
 }
 
@@ -43,55 +38,140 @@ void ESPboy::begin(uint8_t const logo_width, uint8_t const logo_height, uint8_t
     if (_initialized) return;
 
     _init(); if (_buttons) return;
-    _showESPboyLogo();
-    _fadeInOut(1000);
 
-    tft.drawBitmap(
-        (TFT_WIDTH  - logo_width)  >> 1,
-        (TFT_HEIGHT - logo_height) >> 1,
-        logo_bitmap,
-        logo_width,
-        logo_height,
-        logo_color
-    );
+    _logo = { logo_width, logo_height, logo_bitmap, nullptr, nullptr, logo_color, wait_ms };
+    _boot();
 
-    _fadeInOut(wait_ms);
+}
 
-    tft.setTextColor(TFT_WHITE); // reset default color
-    fadeIn();
+void ESPboy::begin(uint8_t const logo_width, uint8_t const logo_height, uint16_t const * const logo_colormap, uint16_t const wait_ms) {
 
-    _initialized = true;
+    if (_initialized) return;
+
+    _init(); if (_buttons) return;
+
+    _logo = { logo_width, logo_height, nullptr, logo_colormap, nullptr, 0, wait_ms };
+    _boot();
 
 }
 
-void ESPboy::begin(uint8_t const logo_width, uint8_t const logo_height, uint16_t const * const logo_colormap, uint16_t const wait_ms) {
+void ESPboy::begin(Asset const &logo, uint16_t const logo_color, uint16_t const wait_ms) {
 
     if (_initialized) return;
 
     _init(); if (_buttons) return;
-    _showESPboyLogo();
-    _fadeInOut(1000);
-
-    tft.pushImage(
-        (TFT_WIDTH  - logo_width)  >> 1,
-        (TFT_HEIGHT - logo_height) >> 1,
-        logo_width,
-        logo_height,
-        logo_colormap
-    );
 
-    _fadeInOut(wait_ms);
+    _logo = { logo.width(), logo.height(), nullptr, nullptr, logo.data(), logo_color, wait_ms };
+    _boot();
+
+}
+
+void ESPboy::setBootPolicy(BootPolicy const policy, bool const splash_on_wake) {
+
+    _boot_policy    = policy;
+    _splash_on_wake = splash_on_wake;
+
+}
+
+bool ESPboy::splashing() const { return _splash != _Splash::NONE; }
+
+BootTimeline const &ESPboy::bootTimeline() const { return _timeline; }
+
+void ESPboy::_boot(char const * const title, uint16 const color) {
+
+    BootPolicy const policy = !_splash_on_wake && hal::Reset::fromDeepSleep()
+        ? BootPolicy::NO_SPLASH
+        : _boot_policy;
+
+    _splash_start_us = micros();
+
+    switch (policy) {
+
+        case BootPolicy::NO_SPLASH:
+            backlight.set(0);
+            tft.fillScreen(0);
+            _endSplash();
+            break;
+
+        case BootPolicy::ASYNC_SPLASH:
+            _showESPboyLogo(title, color);
+            _splash_hold_ms = 1000;
+            _splash         = _Splash::FADE_IN;
+            fadeIn();
+            break;
+
+        default:
+            _showESPboyLogo(title, color);
+            _fadeInOut(1000);
+            if (_logo.width) { _drawLogo(); _fadeInOut(_logo.wait_ms); }
+            _endSplash();
+
+    }
+
+    pacer.begin();
+
+    // registered once, since begin() calls _init() again as long as a button is held
+    scheduler.every(1000, _publishFPS, this);
+
+    _initialized = true;
+
+}
+
+void ESPboy::_splashStep() {
+
+    switch (_splash) {
+
+        case _Splash::FADE_IN:
+            if (backlight.fading()) return;
+            _splash    = _Splash::HOLD;
+            _splash_ms = millis();
+            break;
+
+        case _Splash::HOLD:
+            if (millis() - _splash_ms < _splash_hold_ms) return;
+            _splash = _Splash::FADE_OUT;
+            fadeOut();
+            break;
+
+        default:
+            if (backlight.fading()) return;
+            tft.fillScreen(0);
+            if (_logo.width) {
+                _drawLogo();
+                _logo.width     = 0;
+                _splash_hold_ms = _logo.wait_ms;
+                _splash         = _Splash::FADE_IN;
+                fadeIn();
+            } else _endSplash();
+
+    }
+
+}
+
+void ESPboy::_endSplash() {
 
     tft.setTextColor(TFT_WHITE); // reset default color
     fadeIn();
 
-    _initialized = true;
+    _splash             = _Splash::NONE;
+    _timeline.splash_us = micros() - _splash_start_us;
+
+}
+
+void ESPboy::_drawLogo() {
+
+    int16_t const x = (TFT_WIDTH  - _logo.width)  >> 1;
+    int16_t const y = (TFT_HEIGHT - _logo.height) >> 1;
+
+         if (_logo.bitmap) tft.drawBitmap(x, y, _logo.bitmap, _logo.width, _logo.height, _logo.color);
+    else if (_logo.asset)  Asset(_logo.asset).draw(tft, x, y, _logo.color);
+    else                   tft.pushImage(x, y, _logo.width, _logo.height, _logo.colormap);
 
 }
 
 void ESPboy::_showESPboyLogo(char const * const title, uint16 const color) {
 
-    dac.setVoltage(0, false);
+    backlight.set(0);
 
     uint8_t padding = title == nullptr ? 0 : 16;
     uint8_t y = (TFT_HEIGHT - ESPBOY_LOGO_HEIGHT - 3 - 1 - 3 - 8 - 4 - 8 - 4 - TINY_M1CR0LAB_HEIGHT - padding - 8) >> 1;
@@ -130,20 +210,32 @@ void ESPboy::_showESPboyLogo(char const * const title, uint16 const color) {
 void ESPboy::_init() {
     
     _frame_count = _fps = 0;
+    _i2c_bytes   = _i2c_total = 0;
+    _buttons_us  = _sampled_us = 0;
+    _on_change   = false;
+    _splash      = _Splash::NONE;
+    _timeline    = {};
+
+    uint32_t t = _timeline.begin_us = micros();
 
     dac.begin(0x60);
+    backlight.begin(dac);
     _initMCP23017();
+
+    _timeline.i2c_us = micros() - t; t += _timeline.i2c_us;
     
     tft.init();
     tft.setBrightness(0xff);
 
-    _buttons = ~(mcp.readGPIOAB() & 0xff);
+    _timeline.tft_us = micros() - t;
+
+    _readButtons();
 
 }
 
 void ESPboy::_initMCP23017() {
 
-    mcp.begin_I2C();
+    mcp.begin();
 
     // Buttons
     for (uint8_t i=0; i<8; ++i) mcp.pinMode(i, INPUT_PULLUP);
@@ -158,104 +250,118 @@ void ESPboy::_initMCP23017() {
 }
 
 void ESPboy::update() {
-    
-    if (_fading.active) _fade();
 
-    button.read((_buttons = ~(mcp.readGPIOAB() & 0xff)));
+    pacer.pace();
+    profiler.update();
 
-    pixel.update();
-    
-    _updateFPS();
+    { Profiler::Scope scope(Profiler::FADE); backlight.update(); }
 
-}
-
-uint8_t ESPboy::buttons() const { return _buttons; }
+    if (_splash != _Splash::NONE) _splashStep();
+    else if (!_timeline.first_frame_us) _timeline.first_frame_us = micros();
 
-// To please Roman 😉
-uint8_t ESPboy::getKeys() { return ~(mcp.readGPIOAB() & 0xff); }
+    {
+        Profiler::Scope scope(Profiler::BUTTONS);
+        _readButtons();
 
-void ESPboy::_updateFPS() {
-
-    static uint32_t last_sec = 0;
-    uint32_t const sec = millis() / 1000;
+        uint8_t const buttons = input.frame(_buttons);
+        if (buttons != _buttons) {
+            _buttons    = buttons;
+            _buttons_us = micros();
+        }
 
-    if (sec != last_sec) {
-        _fps = _frame_count;
-        _frame_count = 0;
-        last_sec = sec;
+        button.read(_buttons, _buttons_us);
+        _sampled_us = micros();
     }
 
+    { Profiler::Scope scope(Profiler::PIXEL); pixel.update(); }
+
+    scheduler.run(pacer.frameStart());
     _frame_count++;
 
+    uint32_t const i2c_total = mcp.i2cBytes() + dac.i2cBytes();
+    _i2c_bytes = i2c_total - _i2c_total;
+    _i2c_total = i2c_total;
+
 }
 
-uint32_t ESPboy::fps() const { return _fps; }
+void ESPboy::sample() {
 
-bool ESPboy::fading() const { return _fading.active; }
+    uint32_t const now = micros();
 
-void ESPboy::fadeIn() {
+    if (now - _sampled_us < _SAMPLING_PERIOD_US || input.replaying()) return;
 
-    _fading.last_us = micros();
-    _fading.level   = _DAC_MIN;
-    _fading.inc     = true;
-    _fading.active  = true;
+    _sampled_us = now;
+    _readButtons();
+    button.sample(_buttons, _buttons_us);
 
 }
 
-void ESPboy::fadeOut() {
+void ESPboy::_readButtons() {
 
-    _fading.last_us = micros();
-    _fading.level   = _DAC_MAX;
-    _fading.inc     = false;
-    _fading.active  = true;
+    if (!mcp.changed()) return;
 
-}
+    // buttons are wired to Port A only, and Port B holds nothing but outputs
+    uint8_t const buttons = ~mcp.readGPIOA();
 
-void ESPboy::dim(uint16_t const brightness) {
+    if (buttons != _buttons) {
+        _buttons    = buttons;
+        _buttons_us = _on_change ? mcp.changedAt() : micros();
+    }
 
-    switch (brightness) {
+}
 
-        case _DAC_MIN:
-            dac.setVoltage(0, false);
-            break;
+uint8_t ESPboy::buttons() const { return _buttons; }
 
-        case _DAC_MAX:
-            dac.setVoltage(4095, false);
-            break;
-        
-        default:
-            dac.setVoltage(brightness < 4095 ? brightness : 4095, false);
+// To please Roman 😉
+uint8_t ESPboy::getKeys() { _readButtons(); return _buttons; }
 
-    }
+void ESPboy::pollButtonsOnChange(uint8_t const int_pin) {
+
+    mcp.armInterruptOnChange(0xff, int_pin);
+    pacer.setWakeSource(&mcp);
+    _on_change = true;
 
 }
 
-void ESPboy::_fadeInOut(uint16_t const wait_ms) {
+bool ESPboy::enableDoubleBuffer(uint8_t const height) { return screen.begin(tft, height); }
 
-    fadeIn();  while (_fading.active) _fade(); delay(wait_ms);
-    fadeOut(); while (_fading.active) _fade();
-    tft.fillScreen(0);
+uint32_t ESPboy::i2cBytes() const { return _i2c_bytes; }
+
+void ESPboy::_publishFPS(void * const espboy) {
+
+    ESPboy &self = *static_cast<ESPboy *>(espboy);
+
+    self._fps         = self._frame_count;
+    self._frame_count = 0;
 
 }
 
-void ESPboy::_fade() {
+uint32_t ESPboy::fps() const { return _fps; }
 
-    uint32_t const now = micros();
+bool ESPboy::fading() const { return backlight.fading(); }
 
-    if (now - _fading.last_us > 9999) {
+void ESPboy::fadeIn(uint16_t const duration_ms)  { backlight.fadeIn(duration_ms); }
+void ESPboy::fadeOut(uint16_t const duration_ms) { backlight.fadeOut(duration_ms); }
 
-             if ( _fading.inc && _fading.level + 4 < _DAC_MAX) _fading.level += 4;
-        else if (!_fading.inc && _fading.level - 4 > _DAC_MIN) _fading.level -= 4;
-        else {
-            _fading.active = false;
-            _fading.level  = _fading.inc ? _DAC_MAX : _DAC_MIN;
-        }
+void ESPboy::dim(uint16_t const brightness) {
 
-        dim(_fading.level);
+         if (brightness == Backlight::DAC_MIN) backlight.write(0);
+    else if (brightness == Backlight::DAC_MAX) backlight.write(4095);
+    else                                       backlight.write(brightness < 4095 ? brightness : 4095);
 
-        _fading.last_us = now;
+}
 
-    }
+void ESPboy::_fadeInOut(uint16_t const wait_ms) {
+
+    fadeIn();  _waitFade(); delay(wait_ms);
+    fadeOut(); _waitFade();
+    tft.fillScreen(0);
+
+}
+
+void ESPboy::_waitFade() {
+
+    while (backlight.fading()) { delay(1); backlight.update(); }
 
 }
 
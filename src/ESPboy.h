@@ -8,15 +8,25 @@
 
 #pragma once
 
-#define LGFX_ESPBOY
-#define LGFX_USE_V1
-#include <LovyanGFX.hpp>
-#include <LGFX_AUTODETECT.hpp>
-
-#include <Adafruit_MCP23X17.h>
-#include <Adafruit_MCP4725.h>
+#include "HAL.h"
+#include "Asset.h"
+#include "Backlight.h"
 #include "Button.h"
+#include "DoubleBuffer.h"
+#include "Easing.h"
+#include "FrameBuffer.h"
+#include "FramePacer.h"
+#include "Game2048.h"
+#include "InputLog.h"
+#include "Life.h"
 #include "NeoPixel.h"
+#include "PaletteBuffer.h"
+#include "Profiler.h"
+#include "Particles.h"
+#include "Random.h"
+#include "Scheduler.h"
+#include "StripRenderer.h"
+#include "TileMap.h"
 #include "assets.h"
 
 // To please Roman 😉
@@ -33,6 +43,30 @@ uint8_t constexpr PAD_ANY   = 0xff;
 uint8_t constexpr TFT_WIDTH  = 128;
 uint8_t constexpr TFT_HEIGHT = 128;
 
+/**
+ * @brief How the splash sequence is played by ESPboy::begin().
+ */
+enum class BootPolicy : uint8_t {
+
+    SPLASH,       // begin() returns once the splash sequence is over (default)
+    ASYNC_SPLASH, // begin() returns at once, and update() plays the splash sequence
+    NO_SPLASH     // no splash sequence at all
+
+};
+
+/**
+ * @brief Measured timeline of the boot sequence, in microseconds.
+ */
+struct BootTimeline {
+
+    uint32_t begin_us;       // ESPboy::begin() called (time since reset)
+    uint32_t i2c_us;         // MCP4725 and MCP23017 initialization
+    uint32_t tft_us;         // display initialization
+    uint32_t splash_us;      // splash sequence (played by update() when asynchronous)
+    uint32_t first_frame_us; // first update() after the splash (time since reset)
+
+};
+
 /**
  * @brief The main class of the library providing a driver to control the ESPboy handheld.
  * 
@@ -45,49 +79,77 @@ class ESPboy {
 
         static uint8_t constexpr _MCP23017_TFT_CS_PIN = 8;
 
-        static uint16_t constexpr _DAC_MIN = 650;
-        static uint16_t constexpr _DAC_MAX = 1000;
-
         bool _initialized = false;
 
-        struct Fading {
+        enum class _Splash : uint8_t { NONE, FADE_IN, HOLD, FADE_OUT };
+
+        struct _Logo {
 
-            uint32_t last_us;
-            uint16_t level;
-            bool     inc;
-            bool     active;
+            uint8_t          width; // 0 if there is no custom logo
+            uint8_t          height;
+            uint8_t  const * bitmap;
+            uint16_t const * colormap;
+            uint8_t  const * asset;
+            uint16_t         color;
+            uint16_t         wait_ms;
 
         };
 
+        BootPolicy   _boot_policy    = BootPolicy::SPLASH;
+        bool         _splash_on_wake = true;
+        BootTimeline _timeline;
+        _Splash      _splash;
+        _Logo        _logo;
+        uint16_t     _splash_hold_ms;
+        uint32_t     _splash_ms;
+        uint32_t     _splash_start_us;
+
+        static uint16_t constexpr _SAMPLING_PERIOD_US = 1000;
+
         uint8_t  _buttons;
+        uint32_t _buttons_us;
+        uint32_t _sampled_us;
+        bool     _on_change;
+        uint32_t _i2c_bytes;
+        uint32_t _i2c_total;
         uint32_t _frame_count;
         uint32_t _fps;
-        Fading   _fading;
 
         void _init();
         void _initMCP23017();
+        void _readButtons();
         void _showESPboyLogo(char const * const title = nullptr, uint16 const color = 0xffff);
-        void _updateFPS();
+        static void _publishFPS(void * const espboy);
+
+        void _boot(char const * const title = nullptr, uint16 const color = 0xffff);
+        void _splashStep();
+        void _endSplash();
+        void _drawLogo();
 
         void _fadeInOut(uint16_t const wait_ms = 0);
-        void _fade();
+        void _waitFade();
 
     public:
 
         /**
          * @brief MCP4725 DAC controller.
          */
-        Adafruit_MCP4725 dac;
+        hal::Dac dac;
 
         /**
          * @brief MCP23017 I/O expander controller.
          */
-        Adafruit_MCP23X17 mcp;
+        hal::Expander mcp;
 
         /**
          * @brief Display controller.
          */
-        LGFX tft;
+        hal::Display tft;
+
+        /**
+         * @brief Backlight controller.
+         */
+        Backlight backlight;
 
         /**
          * @brief Push button controller.
@@ -99,6 +161,32 @@ class ESPboy {
          */
         NeoPixel pixel;
 
+        /**
+         * @brief Frame pacing controller.
+         */
+        FramePacer pacer;
+
+        /**
+         * @brief Double-buffered screen (see enableDoubleBuffer()).
+         */
+        DoubleBuffer screen;
+
+        /**
+         * @brief Frame profiler (idle until its begin() method is called).
+         */
+        Profiler profiler;
+
+        /**
+         * @brief Recorder and player of the push buttons (idle until its
+         *        record() or replay() method is called).
+         */
+        InputLog input;
+
+        /**
+         * @brief Timers and background jobs run by update().
+         */
+        Scheduler scheduler;
+
         /**
          * @brief Initializes the ESPboy driver.
          * 
@@ -147,13 +235,68 @@ class ESPboy {
             uint16_t const wait_ms = 1000
         );
 
+        /**
+         * @brief Initializes the ESPboy driver by displaying a custom logo
+         *        stored as a compressed asset at startup.
+         * 
+         * @param logo       Logo asset (see extras/tools/png2asset.py).
+         * @param logo_color Display color of a monochromatic logo in 16-bit format (RGB565).
+         * @param wait_ms    Time length in milliseconds during which the logo must remain displayed.
+         */
+        void begin(Asset const &logo, uint16_t const logo_color = 0xffff, uint16_t const wait_ms = 1000);
+
+        /**
+         * @brief Sets how the splash sequence is played by begin().
+         * 
+         * @param policy         Splash sequence policy.
+         * @param splash_on_wake Whether the splash sequence is played when
+         *                       waking up from deep sleep (true by default,
+         *                       as when setBootPolicy() isn't called).
+         * 
+         * @details Must be called before begin(). With BootPolicy::ASYNC_SPLASH,
+         *          begin() returns as soon as the hardware is initialized, so
+         *          that the game can load its assets while update() plays the
+         *          splash sequence: the game must not draw anything as long
+         *          as splashing() returns true.
+         */
+        void setBootPolicy(BootPolicy const policy, bool const splash_on_wake = true);
+
+        /**
+         * @brief Whether the splash sequence is still being played (see setBootPolicy()).
+         */
+        bool splashing() const;
+
+        /**
+         * @brief Measured timeline of the boot sequence.
+         * 
+         * @details first_frame_us is only known after the first update()
+         *          following the splash sequence.
+         */
+        BootTimeline const &bootTimeline() const;
+
         /**
          * @brief Updates the ESPboy controller state.
          * 
-         * @details Handles button reading and the NeoPixel LED state.
+         * @details Handles frame pacing, backlight fades, the asynchronous splash
+         *          sequence, button reading, the NeoPixel LED state and the
+         *          scheduled tasks.
          */
         void update();
 
+        /**
+         * @brief Samples the push buttons between two updates.
+         * 
+         * @details Call it as often as you like from within long computations
+         *          (for instance once per row of a heavy simulation): the buttons
+         *          are actually read at most once per millisecond, and their state
+         *          changes are timestamped and pushed into the event queue of
+         *          the button controller (see Button::enableEvents()).
+         *          When the interrupt-on-change is armed (see pollButtonsOnChange()),
+         *          Port A is only read when a button has changed, and events are
+         *          stamped with the time of the interrupt.
+         */
+        void sample();
+
         /**
          * @brief Bulk read all push button states.
          * 
@@ -174,6 +317,42 @@ class ESPboy {
          */
         uint8_t getKeys();
 
+        /**
+         * @brief Only reads Port A of the MCP23017 when one of its pins has changed.
+         * 
+         * @param int_pin ESP8266 GPIO wired to the INTA output of the MCP23017.
+         * 
+         * @details By default, the push buttons are polled with an 8-bit read of
+         *          Port A at each update(). Once the interrupt-on-change is armed,
+         *          the read is skipped altogether as long as no button changes state,
+         *          and a button press ends the idle wait of the frame pacer at once.
+         *          This requires the INTA output to be wired to the ESP8266.
+         */
+        void pollButtonsOnChange(uint8_t const int_pin);
+
+        /**
+         * @brief Switches to double-buffered rendering.
+         * 
+         * @param height Height of the two buffers: 64 rows (2 x 16 KB) draws
+         *               a frame in two bands, 128 rows (2 x 32 KB) draws it
+         *               at once but rarely fits in the heap of the ESP8266.
+         * 
+         * @return true if the buffers could be allocated.
+         * 
+         * @details Frames are then drawn into screen.canvas() and handed over
+         *          to the display with screen.present(), which sends them in
+         *          the background while the game goes on.
+         */
+        bool enableDoubleBuffer(uint8_t const height = TFT_HEIGHT >> 1);
+
+        /**
+         * @brief I2C bus traffic.
+         * 
+         * @return The number of bytes exchanged with the MCP23017 and the MCP4725
+         *         during the last frame.
+         */
+        uint32_t i2cBytes() const;
+
         /**
          * @brief Display frequency.
          * 
@@ -191,18 +370,29 @@ class ESPboy {
 
         /**
          * @brief Turns on the screen gradually.
+         * 
+         * @param duration_ms Duration of the fade in milliseconds.
+         * 
+         * @details The fade is played in the background by update()
+         *          (see also backlight.fade() for any other level).
          */
-        void fadeIn();
+        void fadeIn(uint16_t const duration_ms = Backlight::FADE_MS);
 
         /**
          * @brief Turns off the screen gradually.
+         * 
+         * @param duration_ms Duration of the fade in milliseconds.
          */
-        void fadeOut();
+        void fadeOut(uint16_t const duration_ms = Backlight::FADE_MS);
 
         /**
          * @brief Sets the brightness level of the screen.
          * 
          * @param brightness Screen brightness ranging from 0 (turned off) to 4095 (fully enlightened).
+         * 
+         * @details The value is written as is to the DAC, except for 650 which
+         *          turns the screen off, and 1000 which fully enlightens it.
+         *          See backlight.set() for a perceptual brightness scale.
          */
         void dim(uint16_t const brightness);
 
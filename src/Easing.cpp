@@ -0,0 +1,57 @@
+/**
+ * ----------------------------------------------------------------------------
+ * @file   Easing.cpp
+ * @author Stéphane Calderoni (https://github.com/m1cr0lab)
+ * @brief  Easing curves for animations
+ * ----------------------------------------------------------------------------
+ */
+
+#include "Easing.h"
+
+uint8_t Ease::apply(Easing const easing, uint8_t const t) {
+
+    switch (easing) {
+
+        case Easing::LINEAR:      return t;
+        case Easing::EASE_IN:     return t * t >> 8;
+        case Easing::EASE_OUT:    return ~((uint8_t)~t * (uint8_t)~t >> 8);
+        case Easing::EASE_IN_OUT: return sine(t >> 1);
+        default:                  return 0;
+
+    }
+
+}
+
+uint8_t Ease::sine(uint8_t const i) {
+
+    switch (i >> 6) {
+
+        case 0:  return  pgm_read_byte(_FAST_SINE + i);           // [  0 -  63]
+        case 1:  return ~pgm_read_byte(_FAST_SINE + (~i & 0x3f)); // [ 64 - 127]
+        case 2:  return ~pgm_read_byte(_FAST_SINE + ( i & 0x3f)); // [128 - 191]
+        default: return  pgm_read_byte(_FAST_SINE + (~i & 0x3f)); // [192 - 255]
+
+    }
+
+}
+
+/*
+ * ----------------------------------------------------------------------------
+ * ESPboy Library
+ * ----------------------------------------------------------------------------
+ * Copyright (c) 2021-2022 Stéphane Calderoni (https://github.com/m1cr0lab)
+ * 
+ * This program is free software: you can redistribute it and/or modify
+ * it under the terms of the GNU General Public License as published by
+ * the Free Software Foundation, either version 3 of the License, or
+ * (at your option) any later version.
+ * 
+ * This program is distributed in the hope that it will be useful,
+ * but WITHOUT ANY WARRANTY; without even the implied warranty of
+ * MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE. See the
+ * GNU General Public License for more details.
+ * 
+ * You should have received a copy of the GNU General Public License
+ * along with this program. If not, see <https://www.gnu.org/licenses/>.
+ * ----------------------------------------------------------------------------
+ */
\ No newline at end of file
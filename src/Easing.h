@@ -0,0 +1,83 @@
+/**
+ * ----------------------------------------------------------------------------
+ * @file   Easing.h
+ * @author Stéphane Calderoni (https://github.com/m1cr0lab)
+ * @brief  Easing curves for animations
+ * ----------------------------------------------------------------------------
+ */
+
+#pragma once
+
+#include <Arduino.h>
+
+/**
+ * @brief Easing curves of a transition.
+ */
+enum class Easing : uint8_t {
+
+    STEP,        // holds the start value, then jumps to the end one
+    LINEAR,
+    EASE_IN,     // quadratic
+    EASE_OUT,    // quadratic
+    EASE_IN_OUT  // sine
+
+};
+
+/**
+ * @brief Integer evaluation of the easing curves.
+ */
+class Ease {
+
+    private:
+
+        // first quarter of a sine wave
+        static uint8_t const constexpr _FAST_SINE[] PROGMEM = {
+
+              0,   0,   0,   0,   1,   1,   1,   2,   2,   3,   4,   5,   6,   6,   8,   9,
+             10,  11,  12,  14,  15,  17,  18,  20,  22,  23,  25,  27,  29,  31,  33,  35,
+             38,  40,  42,  45,  47,  49,  52,  54,  57,  60,  62,  65,  68,  71,  73,  76,
+             79,  82,  85,  88,  91,  94,  97, 100, 103, 106, 109, 113, 116, 119, 122, 125
+
+        };
+
+    public:
+
+        /**
+         * @brief Progress of a transition along an easing curve.
+         * 
+         * @param easing Easing curve.
+         * @param t      Elapsed time ranging from 0 (start) to 255 (almost over).
+         * 
+         * @return Progress ranging from 0 (start value) to 255 (end value).
+         */
+        static uint8_t apply(Easing const easing, uint8_t const t);
+
+        /**
+         * @brief A full sine wave cycle, ranging from 0 to 255 and back to 0.
+         * 
+         * @param i Phase ranging from 0 to 255.
+         */
+        static uint8_t sine(uint8_t const i);
+
+};
+
+/*
+ * ----------------------------------------------------------------------------
+ * ESPboy Library
+ * ----------------------------------------------------------------------------
+ * Copyright (c) 2021-2022 Stéphane Calderoni (https://github.com/m1cr0lab)
+ * 
+ * This program is free software: you can redistribute it and/or modify
+ * it under the terms of the GNU General Public License as published by
+ * the Free Software Foundation, either version 3 of the License, or
+ * (at your option) any later version.
+ * 
+ * This program is distributed in the hope that it will be useful,
+ * but WITHOUT ANY WARRANTY; without even the implied warranty of
+ * MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE. See the
+ * GNU General Public License for more details.
+ * 
+ * You should have received a copy of the GNU General Public License
+ * along with this program. If not, see <https://www.gnu.org/licenses/>.
+ * ----------------------------------------------------------------------------
+ */
\ No newline at end of file
@@ -0,0 +1,340 @@
+/**
+ * ----------------------------------------------------------------------------
+ * @file   FrameBuffer.cpp
+ * @author Stéphane Calderoni (https://github.com/m1cr0lab)
+ * @brief  Full-screen framebuffer with dirty tile tracking
+ * ----------------------------------------------------------------------------
+ */
+
+#include "FrameBuffer.h"
+#include "Profiler.h"
+
+#include <new>
+
+FrameBuffer::FrameBuffer(hal::Display &tft)
+: _tft(&tft)
+, _sprite(&tft)
+, _hash(nullptr)
+, _clear_color(0)
+, _cleared(false)
+, _flushed_pixels(0)
+, _text_datum(0)
+{}
+
+FrameBuffer::~FrameBuffer() { end(); }
+
+bool FrameBuffer::begin(bool const compare) {
+
+    _sprite.setColorDepth(16);
+    if (!_sprite.createSprite(WIDTH, HEIGHT)) return false;
+
+    if (compare) {
+        _hash = new (std::nothrow) uint32_t[_COLS * _ROWS];
+        if (!_hash) { _sprite.deleteSprite(); return false; }
+    }
+
+    _cleared = false;
+    clear();
+
+    return true;
+
+}
+
+void FrameBuffer::end() {
+
+    _sprite.deleteSprite();
+    delete[] _hash;
+    _hash = nullptr;
+
+}
+
+hal::Sprite &FrameBuffer::sprite() { return _sprite; }
+
+void FrameBuffer::invalidate() {
+
+    for (uint8_t row = 0; row < _ROWS; ++row) _dirty[row] = 0xffff;
+
+    // the content of the display is unknown
+    if (_hash) memset(_hash, 0xff, _COLS * _ROWS * sizeof(uint32_t));
+
+}
+
+void FrameBuffer::markDirty(int32_t const x, int32_t const y, int32_t const w, int32_t const h) { _mark(x, y, w, h); }
+
+void FrameBuffer::_mark(int32_t x, int32_t y, int32_t w, int32_t h) {
+
+    if (x < 0) { w += x; x = 0; }
+    if (y < 0) { h += y; y = 0; }
+    if (x + w > WIDTH)  w = WIDTH  - x;
+    if (y + h > HEIGHT) h = HEIGHT - y;
+    if (w <= 0 || h <= 0) return;
+
+    uint8_t const c0 = x >> _TILE_SHIFT;
+    uint8_t const c1 = (x + w - 1) >> _TILE_SHIFT;
+    uint8_t const r0 = y >> _TILE_SHIFT;
+    uint8_t const r1 = (y + h - 1) >> _TILE_SHIFT;
+
+    uint16_t const cols = (uint16_t)((0xffff << c0) & (0xffff >> (15 - c1)));
+
+    for (uint8_t row = r0; row <= r1; ++row) {
+        _dirty[row] |= cols;
+        _drawn[row] |= cols;
+    }
+
+}
+
+void FrameBuffer::clear(uint16_t const color) {
+
+    if (!_cleared || color != _clear_color) {
+
+        _sprite.fillScreen(_clear_color = color);
+        for (uint8_t row = 0; row < _ROWS; ++row) { _dirty[row] = 0xffff; _drawn[row] = 0; }
+        _cleared = true;
+        return;
+
+    }
+
+    // only the tiles drawn since the last clear need to be restored
+    for (uint8_t row = 0; row < _ROWS; ++row) {
+
+        uint16_t drawn = _drawn[row];
+        if (!drawn) continue;
+
+        _dirty[row] |= drawn;
+        _drawn[row]  = 0;
+
+        uint8_t col = 0;
+        while (drawn) {
+            while (!(drawn & 1)) { drawn >>= 1; col++; }
+            uint8_t n = 0;
+            while (drawn & 1) { drawn >>= 1; n++; }
+            _sprite.fillRect(col << _TILE_SHIFT, row << _TILE_SHIFT, n << _TILE_SHIFT, _TILE_SIZE, color);
+            col += n;
+        }
+
+    }
+
+}
+
+uint32_t FrameBuffer::_tileHash(uint8_t const col, uint8_t const row) const {
+
+    uint16_t const *p = (uint16_t const *)_sprite.getBuffer() + (row << _TILE_SHIFT) * WIDTH + (col << _TILE_SHIFT);
+    uint32_t h = 2166136261UL;
+
+    for (uint8_t j = 0; j < _TILE_SIZE; ++j, p += WIDTH) {
+        for (uint8_t i = 0; i < _TILE_SIZE; ++i) h = (h ^ p[i]) * 16777619UL; // FNV-1a
+    }
+
+    return h;
+
+}
+
+void FrameBuffer::_discardUnchanged() {
+
+    for (uint8_t row = 0; row < _ROWS; ++row) {
+
+        uint16_t dirty = _dirty[row];
+
+        for (uint8_t col = 0; dirty; ++col, dirty >>= 1) {
+            if (!(dirty & 1)) continue;
+            uint32_t * const h = &_hash[row * _COLS + col];
+            uint32_t const hash = _tileHash(col, row);
+            if (hash == *h) _dirty[row] &= ~(1 << col);
+            else *h = hash;
+        }
+
+    }
+
+}
+
+void FrameBuffer::flush() {
+
+    Profiler::Scope scope(Profiler::FLUSH);
+
+    if (_hash) _discardUnchanged();
+
+    _flushed_pixels = 0;
+
+    _tft->startWrite();
+
+    for (uint8_t row = 0; row < _ROWS; ++row) {
+
+        while (_dirty[row]) {
+
+            // first run of dirty tiles on this row...
+            uint16_t const dirty = _dirty[row];
+            uint8_t  const col   = __builtin_ctz(dirty);
+            uint16_t const rest  = ~dirty >> col;
+            uint8_t  const n     = rest ? __builtin_ctz(rest) : 16 - col;
+            uint16_t const run   = (uint16_t)(((1 << n) - 1) << col);
+
+            // ...extended downwards as long as the rows below contain it
+            uint8_t rows = 1;
+            while (row + rows < _ROWS && (_dirty[row + rows] & run) == run) rows++;
+            for (uint8_t r = 0; r < rows; ++r) _dirty[row + r] &= ~run;
+
+            int32_t const x = col << _TILE_SHIFT;
+            int32_t const y = row << _TILE_SHIFT;
+            int32_t const w = n << _TILE_SHIFT;
+            int32_t const h = rows << _TILE_SHIFT;
+
+            _tft->setClipRect(x, y, w, h);
+            _sprite.pushSprite(0, 0);
+            _flushed_pixels += w * h;
+
+        }
+
+    }
+
+    _tft->clearClipRect();
+    _tft->endWrite();
+
+}
+
+uint32_t FrameBuffer::flushedPixels() const { return _flushed_pixels; }
+
+void FrameBuffer::drawPixel(int32_t const x, int32_t const y, uint16_t const color) {
+
+    _sprite.drawPixel(x, y, color);
+    _mark(x, y, 1, 1);
+
+}
+
+void FrameBuffer::drawFastHLine(int32_t const x, int32_t const y, int32_t const w, uint16_t const color) {
+
+    _sprite.drawFastHLine(x, y, w, color);
+    _mark(x, y, w, 1);
+
+}
+
+void FrameBuffer::drawFastVLine(int32_t const x, int32_t const y, int32_t const h, uint16_t const color) {
+
+    _sprite.drawFastVLine(x, y, h, color);
+    _mark(x, y, 1, h);
+
+}
+
+void FrameBuffer::drawRect(int32_t const x, int32_t const y, int32_t const w, int32_t const h, uint16_t const color) {
+
+    _sprite.drawRect(x, y, w, h, color);
+    _mark(x, y, w, h);
+
+}
+
+void FrameBuffer::fillRect(int32_t const x, int32_t const y, int32_t const w, int32_t const h, uint16_t const color) {
+
+    _sprite.fillRect(x, y, w, h, color);
+    _mark(x, y, w, h);
+
+}
+
+void FrameBuffer::fillRoundRect(int32_t const x, int32_t const y, int32_t const w, int32_t const h, int32_t const r, uint16_t const color) {
+
+    _sprite.fillRoundRect(x, y, w, h, r, color);
+    _mark(x, y, w, h);
+
+}
+
+void FrameBuffer::drawBitmap(int32_t const x, int32_t const y, uint8_t const *bitmap, int32_t const w, int32_t const h, uint16_t const color) {
+
+    _sprite.drawBitmap(x, y, bitmap, w, h, color);
+    _mark(x, y, w, h);
+
+}
+
+void FrameBuffer::pushImage(int32_t const x, int32_t const y, int32_t const w, int32_t const h, uint16_t const *data) {
+
+    _sprite.pushImage(x, y, w, h, data);
+    _mark(x, y, w, h);
+
+}
+
+void FrameBuffer::pushImage(int32_t const x, int32_t const y, int32_t const w, int32_t const h, uint16_t const *data, uint16_t const transparent) {
+
+    _sprite.pushImage(x, y, w, h, data, transparent);
+    _mark(x, y, w, h);
+
+}
+
+void FrameBuffer::setTextColor(uint16_t const color)                   { _sprite.setTextColor(color);  }
+void FrameBuffer::setTextColor(uint16_t const fg, uint16_t const bg)   { _sprite.setTextColor(fg, bg); }
+void FrameBuffer::setTextDatum(uint8_t const datum) { _sprite.setTextDatum(_text_datum = datum); }
+
+/**
+ * @note LovyanGFX text datums: bits 0-1 give the horizontal alignment
+ *       (left, center, right), bits 2-3 the vertical one (top, middle,
+ *       bottom), and bit 4 the baseline alignment.
+ */
+void FrameBuffer::_markText(int32_t const x, int32_t const y, int32_t const w, uint8_t const datum) {
+
+    int32_t const h = _sprite.fontHeight();
+    int32_t const l = x - ((datum & 0x3) == 1 ? w >> 1 : (datum & 0x3) == 2 ? w : 0);
+
+    if (datum & 0x10) _mark(l, y - h, w, h << 1); // baseline: be conservative
+    else _mark(l, y - ((datum & 0xc) == 4 ? h >> 1 : (datum & 0xc) == 8 ? h : 0), w, h);
+
+}
+
+void FrameBuffer::drawString(char const *text, int32_t const x, int32_t const y) {
+
+    _sprite.drawString(text, x, y);
+    _markText(x, y, _sprite.textWidth(text), _text_datum);
+
+}
+
+void FrameBuffer::drawString(__FlashStringHelper const *text, int32_t const x, int32_t const y) {
+
+    uint8_t len = strlen_P((PGM_P)text);
+    char    buffer[len + 1];
+    strncpy_P(buffer, (PGM_P)text, len + 1);
+
+    drawString(buffer, x, y);
+
+}
+
+void FrameBuffer::drawCenterString(char const *text, int32_t const x, int32_t const y) {
+
+    _sprite.drawCenterString(text, x, y);
+    _markText(x, y, _sprite.textWidth(text), 1); // top center
+
+}
+
+void FrameBuffer::drawCenterString(__FlashStringHelper const *text, int32_t const x, int32_t const y) {
+
+    uint8_t len = strlen_P((PGM_P)text);
+    char    buffer[len + 1];
+    strncpy_P(buffer, (PGM_P)text, len + 1);
+
+    drawCenterString(buffer, x, y);
+
+}
+
+void FrameBuffer::drawNumber(long const number, int32_t const x, int32_t const y) {
+
+    char buffer[12];
+    snprintf(buffer, sizeof(buffer), "%ld", number);
+
+    drawString(buffer, x, y);
+
+}
+
+/*
+ * ----------------------------------------------------------------------------
+ * ESPboy Library
+ * ----------------------------------------------------------------------------
+ * Copyright (c) 2021-2022 Stéphane Calderoni (https://github.com/m1cr0lab)
+ * 
+ * This program is free software: you can redistribute it and/or modify
+ * it under the terms of the GNU General Public License as published by
+ * the Free Software Foundation, either version 3 of the License, or
+ * (at your option) any later version.
+ * 
+ * This program is distributed in the hope that it will be useful,
+ * but WITHOUT ANY WARRANTY; without even the implied warranty of
+ * MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE. See the
+ * GNU General Public License for more details.
+ * 
+ * You should have received a copy of the GNU General Public License
+ * along with this program. If not, see <https://www.gnu.org/licenses/>.
+ * ----------------------------------------------------------------------------
+ */
\ No newline at end of file
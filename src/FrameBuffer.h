@@ -0,0 +1,151 @@
+/**
+ * ----------------------------------------------------------------------------
+ * @file   FrameBuffer.h
+ * @author Stéphane Calderoni (https://github.com/m1cr0lab)
+ * @brief  Full-screen framebuffer with dirty tile tracking
+ * ----------------------------------------------------------------------------
+ */
+
+#pragma once
+
+#include "HAL.h"
+
+/**
+ * @brief This class provides a full-screen 16-bit framebuffer which only
+ *        pushes to the display the regions that have actually changed.
+ * 
+ * @details The screen is divided into 8x8 pixel tiles. Each drawing primitive
+ *          marks the tiles it covers as dirty, and flush() only sends the dirty
+ *          tiles to the display, merged into rectangles.
+ * 
+ *          Clearing the framebuffer with the same color as the previous clear
+ *          only restores the tiles drawn since then, so that the usual pattern
+ *          "clear, draw everything, flush" only costs the moving parts.
+ * 
+ *          With content comparison enabled, flush() also skips the dirty tiles
+ *          whose content has not changed since they were last sent, which suits
+ *          games that redraw a mostly static screen at each frame.
+ * 
+ *          Drawing operations performed directly on sprite() must be reported
+ *          with markDirty().
+ */
+class FrameBuffer {
+
+    private:
+
+        static uint8_t constexpr _TILE_SHIFT = 3;
+        static uint8_t constexpr _TILE_SIZE  = 1 << _TILE_SHIFT;
+        static uint8_t constexpr _COLS       = 128 >> _TILE_SHIFT;
+        static uint8_t constexpr _ROWS       = 128 >> _TILE_SHIFT;
+
+        hal::Display *_tft;
+        hal::Sprite   _sprite;
+
+        uint16_t  _dirty[_ROWS]; // tiles to be pushed to the display (1 bit per column)
+        uint16_t  _drawn[_ROWS]; // tiles drawn since the last clear
+        uint32_t *_hash;         // content of each tile when it was last pushed
+        uint16_t  _clear_color;
+        bool      _cleared;
+        uint32_t  _flushed_pixels;
+
+        uint8_t _text_datum;
+
+        void     _mark(int32_t x, int32_t y, int32_t w, int32_t h);
+        void     _markText(int32_t const x, int32_t const y, int32_t const w, uint8_t const datum);
+        uint32_t _tileHash(uint8_t const col, uint8_t const row) const;
+        void     _discardUnchanged();
+
+    public:
+
+        static uint8_t constexpr WIDTH  = 128;
+        static uint8_t constexpr HEIGHT = 128;
+
+        /**
+         * @param tft Display controller the framebuffer is flushed to (typically espboy.tft).
+         */
+        FrameBuffer(hal::Display &tft);
+        ~FrameBuffer();
+
+        /**
+         * @brief Allocates the framebuffer (32 KB of heap).
+         * 
+         * @param compare Enables content comparison (1 KB of extra heap).
+         * 
+         * @return true if the allocation has succeeded.
+         */
+        bool begin(bool const compare = false);
+
+        /**
+         * @brief Releases the framebuffer.
+         */
+        void end();
+
+        /**
+         * @brief Gives access to the underlying sprite and its whole drawing API.
+         */
+        hal::Sprite &sprite();
+
+        /**
+         * @brief Reports a region modified directly through sprite().
+         */
+        void markDirty(int32_t const x, int32_t const y, int32_t const w, int32_t const h);
+
+        /**
+         * @brief Forces the next flush() to push the whole screen.
+         */
+        void invalidate();
+
+        /**
+         * @brief Pushes the dirty regions to the display.
+         */
+        void flush();
+
+        /**
+         * @brief Number of pixels pushed to the display by the last flush().
+         * 
+         * @details The SPI traffic amounts to 2 bytes per pixel.
+         */
+        uint32_t flushedPixels() const;
+
+        void clear(uint16_t const color = 0);
+        void drawPixel(int32_t const x, int32_t const y, uint16_t const color);
+        void drawFastHLine(int32_t const x, int32_t const y, int32_t const w, uint16_t const color);
+        void drawFastVLine(int32_t const x, int32_t const y, int32_t const h, uint16_t const color);
+        void drawRect(int32_t const x, int32_t const y, int32_t const w, int32_t const h, uint16_t const color);
+        void fillRect(int32_t const x, int32_t const y, int32_t const w, int32_t const h, uint16_t const color);
+        void fillRoundRect(int32_t const x, int32_t const y, int32_t const w, int32_t const h, int32_t const r, uint16_t const color);
+        void drawBitmap(int32_t const x, int32_t const y, uint8_t const *bitmap, int32_t const w, int32_t const h, uint16_t const color);
+        void pushImage(int32_t const x, int32_t const y, int32_t const w, int32_t const h, uint16_t const *data);
+        void pushImage(int32_t const x, int32_t const y, int32_t const w, int32_t const h, uint16_t const *data, uint16_t const transparent);
+
+        void setTextColor(uint16_t const color);
+        void setTextColor(uint16_t const fg, uint16_t const bg);
+        void setTextDatum(uint8_t const datum);
+        void drawString(char const *text, int32_t const x, int32_t const y);
+        void drawString(__FlashStringHelper const *text, int32_t const x, int32_t const y);
+        void drawCenterString(char const *text, int32_t const x, int32_t const y);
+        void drawCenterString(__FlashStringHelper const *text, int32_t const x, int32_t const y);
+        void drawNumber(long const number, int32_t const x, int32_t const y);
+
+};
+
+/*
+ * ----------------------------------------------------------------------------
+ * ESPboy Library
+ * ----------------------------------------------------------------------------
+ * Copyright (c) 2021-2022 Stéphane Calderoni (https://github.com/m1cr0lab)
+ * 
+ * This program is free software: you can redistribute it and/or modify
+ * it under the terms of the GNU General Public License as published by
+ * the Free Software Foundation, either version 3 of the License, or
+ * (at your option) any later version.
+ * 
+ * This program is distributed in the hope that it will be useful,
+ * but WITHOUT ANY WARRANTY; without even the implied warranty of
+ * MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE. See the
+ * GNU General Public License for more details.
+ * 
+ * You should have received a copy of the GNU General Public License
+ * along with this program. If not, see <https://www.gnu.org/licenses/>.
+ * ----------------------------------------------------------------------------
+ */
\ No newline at end of file
@@ -0,0 +1,219 @@
+/**
+ * ----------------------------------------------------------------------------
+ * @file   FramePacer.cpp
+ * @author Stéphane Calderoni (https://github.com/m1cr0lab)
+ * @brief  Frame pacing and frame time statistics
+ * ----------------------------------------------------------------------------
+ */
+
+#include "FramePacer.h"
+
+void FramePacer::begin() {
+
+    _frame_start_us = _next_frame_us = micros();
+    _delta_us       = _accumulator_us = 0;
+    _ticks          = 1;
+    _work_index     = _work_count = 0;
+    _woken          = false;
+
+    resetPower();
+
+}
+
+void FramePacer::setFrameRate(uint8_t const fps) {
+
+    _frame_us      = fps ? 1000000UL / fps : 0;
+    _next_frame_us = micros() + _frame_us;
+
+}
+
+void FramePacer::setTickRate(uint16_t const hz) {
+
+    _tick_us        = hz ? 1000000UL / hz : 0;
+    _accumulator_us = 0;
+
+}
+
+void FramePacer::pace() {
+
+    uint32_t now = micros();
+
+    _record(now - _frame_start_us);
+    _active_us += now - _frame_start_us;
+
+    if (_frame_us) {
+
+        int32_t const ahead = _next_frame_us - now;
+
+        if (ahead > 0) {
+            _idle(ahead);
+            uint32_t const idle_end = micros();
+            _idle_us += idle_end - now;
+            now = idle_end;
+            _next_frame_us = _woken ? now + _frame_us : _next_frame_us + _frame_us;
+        } else if ((uint32_t)-ahead > _frame_us) {
+            _next_frame_us = now + _frame_us; // too late: resynchronize
+        } else {
+            _next_frame_us += _frame_us;
+        }
+
+    }
+
+    _delta_us       = now - _frame_start_us;
+    _frame_start_us = now;
+
+    if (_tick_us) {
+
+        _accumulator_us += _delta_us;
+
+        uint32_t n = _accumulator_us / _tick_us;
+
+        if (n > _MAX_TICKS) {
+            n = _MAX_TICKS;
+            _accumulator_us = 0; // drop the time that cannot be simulated
+        } else _accumulator_us -= n * _tick_us;
+
+        _ticks = n;
+
+    } else _ticks = 1;
+
+}
+
+void FramePacer::_idle(uint32_t const us) {
+
+    _woken = false;
+
+    // delay() lets the system tasks run while we wait
+    if (!_wake_source) {
+        if (us > 1000) delay(us / 1000);
+    } else {
+        // in 1 ms slices, so that a button can end the wait
+        while ((int32_t)(_next_frame_us - micros()) > 1000) {
+            if (_wake_source->changed()) { _woken = true; _wakeups++; return; }
+            delay(1);
+        }
+    }
+
+    uint32_t const left = _next_frame_us - micros();
+    if ((int32_t)left > 0) delayMicroseconds(left);
+
+}
+
+void FramePacer::setWakeSource(hal::Expander * const mcp) { _wake_source = mcp; }
+
+void FramePacer::setCurrentDraw(uint16_t const active_ma, uint16_t const idle_ma) {
+
+    _active_ma = active_ma;
+    _idle_ma   = idle_ma;
+
+}
+
+PowerStats FramePacer::power() const {
+
+    uint64_t const total_us = _active_us + _idle_us;
+
+    // mA x µs / 3.6e6 = µAh
+    return {
+        (uint32_t)(_active_us / 1000),
+        (uint32_t)(_idle_us / 1000),
+        (uint16_t)(total_us ? _active_us * 1000 / total_us : 0),
+        _wakeups,
+        (uint32_t)((_active_us * _active_ma + _idle_us * _idle_ma) / 3600000)
+    };
+
+}
+
+void FramePacer::resetPower() {
+
+    _active_us = _idle_us = 0;
+    _wakeups   = 0;
+
+}
+
+void FramePacer::_record(uint32_t const work_us) {
+
+    _work_us[_work_index] = work_us < 0xffff ? work_us : 0xffff;
+    _work_index = (_work_index + 1) % _WINDOW;
+    if (_work_count < _WINDOW) _work_count++;
+
+}
+
+uint8_t  FramePacer::ticks()      const { return _ticks;          }
+uint32_t FramePacer::delta()      const { return _delta_us;       }
+uint32_t FramePacer::frameStart() const { return _frame_start_us; }
+
+uint8_t FramePacer::alpha() const {
+
+    return _tick_us ? (_accumulator_us << 8) / _tick_us : 0;
+
+}
+
+uint32_t FramePacer::frameTime() const {
+
+    return _work_count ? _work_us[(_work_index + _WINDOW - 1) % _WINDOW] : 0;
+
+}
+
+FrameStats FramePacer::stats() const {
+
+    FrameStats s = { 0, 0, 0, 0, _work_count };
+
+    if (!_work_count) return s;
+
+    // The 99th percentile is the k-th longest frame of the window:
+    // the k longest frames are kept sorted in descending order.
+    static uint8_t constexpr K = _WINDOW / 100 + 1;
+
+    uint16_t top[K] = {};
+    uint32_t sum    = 0;
+
+    s.min_us = 0xffff;
+
+    for (uint16_t i = 0; i < _work_count; ++i) {
+
+        uint16_t const t = _work_us[i];
+
+        sum += t;
+        if (t < s.min_us) s.min_us = t;
+
+        for (uint8_t j = 0; j < K; ++j) {
+            if (t > top[j]) {
+                for (uint8_t k = K - 1; k > j; --k) top[k] = top[k-1];
+                top[j] = t;
+                break;
+            }
+        }
+
+    }
+
+    // nearest rank ceil(0.99 * n) from the bottom, i.e. n / 100 + 1 from the top
+    uint8_t const k = _work_count / 100 + 1;
+
+    s.max_us = top[0];
+    s.avg_us = sum / _work_count;
+    s.p99_us = top[k - 1];
+
+    return s;
+
+}
+
+/*
+ * ----------------------------------------------------------------------------
+ * ESPboy Library
+ * ----------------------------------------------------------------------------
+ * Copyright (c) 2021-2022 Stéphane Calderoni (https://github.com/m1cr0lab)
+ * 
+ * This program is free software: you can redistribute it and/or modify
+ * it under the terms of the GNU General Public License as published by
+ * the Free Software Foundation, either version 3 of the License, or
+ * (at your option) any later version.
+ * 
+ * This program is distributed in the hope that it will be useful,
+ * but WITHOUT ANY WARRANTY; without even the implied warranty of
+ * MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE. See the
+ * GNU General Public License for more details.
+ * 
+ * You should have received a copy of the GNU General Public License
+ * along with this program. If not, see <https://www.gnu.org/licenses/>.
+ * ----------------------------------------------------------------------------
+ */
\ No newline at end of file
@@ -0,0 +1,224 @@
+/**
+ * ----------------------------------------------------------------------------
+ * @file   FramePacer.h
+ * @author Stéphane Calderoni (https://github.com/m1cr0lab)
+ * @brief  Frame pacing and frame time statistics
+ * ----------------------------------------------------------------------------
+ */
+
+#pragma once
+
+#include <Arduino.h>
+#include "HAL.h"
+
+/**
+ * @brief Frame time statistics over the last frames.
+ */
+struct FrameStats {
+
+    uint32_t min_us; // shortest frame
+    uint32_t avg_us; // average frame
+    uint32_t max_us; // longest frame
+    uint32_t p99_us; // 99th percentile
+    uint16_t frames; // number of frames taken into account
+
+};
+
+/**
+ * @brief Time spent working and idling since FramePacer::begin() or resetPower().
+ */
+struct PowerStats {
+
+    uint32_t active_ms;  // time spent on the frames
+    uint32_t idle_ms;    // time spent waiting for the frame deadlines
+    uint16_t duty;       // share of the time spent working, in per mille
+    uint32_t wakeups;    // frames started ahead of their deadline by a button
+    uint32_t charge_uah; // estimated charge drawn, in µAh (see setCurrentDraw())
+
+};
+
+/**
+ * @brief This class provides a controller to hold a steady frame rate,
+ *        to run the game simulation at a fixed timestep, and to measure
+ *        the time actually spent on each frame.
+ * 
+ * @details The pacer is driven by ESPboy::update(), which marks the end
+ *          of a frame and the start of the next one. A typical loop is:
+ * 
+ *            void loop() {
+ *                espboy.update();
+ *                for (uint8_t n = espboy.pacer.ticks(); n; --n) simulate();
+ *                render();
+ *            }
+ * 
+ *          Between two frames, the CPU idles in delay(), which hands it over
+ *          to the system until the deadline instead of spinning on update()
+ *          and polling the buttons. When the interrupt-on-change of the push
+ *          buttons is armed (see ESPboy::pollButtonsOnChange()), a button
+ *          ends the wait at once: a turn-based game can then run at a low
+ *          frame rate without any input lag.
+ */
+class FramePacer {
+
+    private:
+
+        static uint16_t constexpr _WINDOW    = 256; // frames
+        static uint8_t  constexpr _MAX_TICKS = 4;   // per frame
+
+        uint32_t _frame_us;       // target frame period (0 if unlimited)
+        uint32_t _tick_us;        // fixed timestep (0 if variable)
+        uint32_t _next_frame_us;  // deadline of the current frame
+        uint32_t _frame_start_us;
+        uint32_t _delta_us;
+        uint32_t _accumulator_us;
+        uint8_t  _ticks;
+
+        hal::Expander *_wake_source = nullptr;
+        bool           _woken;
+        uint64_t       _active_us;
+        uint64_t       _idle_us;
+        uint32_t       _wakeups;
+        uint16_t       _active_ma = 0;
+        uint16_t       _idle_ma   = 0;
+
+        uint16_t _work_us[_WINDOW]; // frame times, saturated at 65535 us
+        uint16_t _work_index;
+        uint16_t _work_count;
+
+        void _record(uint32_t const work_us);
+        void _idle(uint32_t const us);
+
+    public:
+
+        /**
+         * @brief Resets the pacer, typically once initialization is complete.
+         */
+        void begin();
+
+        /**
+         * @brief Ends the current frame and starts the next one.
+         * 
+         * @details Records the time spent on the frame, waits for the next frame
+         *          deadline when a target frame rate is set, then computes the
+         *          number of fixed timesteps to simulate.
+         */
+        void pace();
+
+        /**
+         * @brief Sets the target frame rate.
+         * 
+         * @param fps Frames per second, or 0 to run as fast as possible (default).
+         * 
+         * @details When ahead of schedule, the CPU idles until the next frame deadline
+         *          instead of spinning. A frame that falls behind by more than a full
+         *          period resynchronizes the schedule rather than trying to catch up.
+         */
+        void setFrameRate(uint8_t const fps);
+
+        /**
+         * @brief Sets the rate of the fixed timestep simulation.
+         * 
+         * @param hz Simulation updates per second, or 0 for one update per frame (default).
+         */
+        void setTickRate(uint16_t const hz);
+
+        /**
+         * @brief Number of simulation updates to run during this frame.
+         * 
+         * @details With a fixed timestep, the elapsed time is accumulated and consumed
+         *          in whole timesteps (at most 4 per frame, to avoid a spiral of death
+         *          when the simulation cannot keep up). Otherwise, always 1.
+         */
+        uint8_t ticks() const;
+
+        /**
+         * @brief Fraction of a timestep left in the accumulator, for render interpolation.
+         * 
+         * @return A value ranging from 0 to 255 (always 0 with a variable timestep).
+         */
+        uint8_t alpha() const;
+
+        /**
+         * @brief Time elapsed between the start of the previous frame and the start of this one.
+         * 
+         * @return The frame period in microseconds.
+         */
+        uint32_t delta() const;
+
+        /**
+         * @brief Time spent on the last frame (excluding the time spent idling).
+         * 
+         * @return The frame time in microseconds.
+         */
+        uint32_t frameTime() const;
+
+        /**
+         * @brief Time at which the current frame started (when pace() returned).
+         * 
+         * @return The time in microseconds, as given by micros().
+         */
+        uint32_t frameStart() const;
+
+        /**
+         * @brief Frame time statistics over the last 256 frames (idle time excluded).
+         * 
+         * @details Frame times are saturated at 65535 us. The 99th percentile
+         *          is taken with the nearest-rank method: the frame time below
+         *          which ceil(0.99 * n) of the n frames fall.
+         */
+        FrameStats stats() const;
+
+        /**
+         * @brief Ends the wait for the frame deadline as soon as a push button changes.
+         * 
+         * @param mcp I/O expander whose interrupt-on-change is armed, or nullptr
+         *            to always wait until the deadline.
+         * 
+         * @details Called by ESPboy::pollButtonsOnChange(). The frame that
+         *          starts early resynchronizes the schedule.
+         */
+        void setWakeSource(hal::Expander * const mcp);
+
+        /**
+         * @brief Sets the current drawn by the whole unit while working and while idling,
+         *        from which power() estimates the charge drawn from the battery.
+         * 
+         * @param active_ma Current in mA while the frames are computed.
+         * @param idle_ma   Current in mA while waiting for the frame deadlines.
+         * 
+         * @details Both depend on the board, the screen brightness and the radio
+         *          state, and are best measured on the unit (for instance with a
+         *          USB power meter, once with a game running flat out and once
+         *          with a game idling at a low frame rate). Until they are set,
+         *          the estimated charge remains 0.
+         */
+        void setCurrentDraw(uint16_t const active_ma, uint16_t const idle_ma);
+
+        /**
+         * @brief Duty cycle and energy estimate since begin() or resetPower().
+         */
+        PowerStats power() const;
+        void resetPower();
+
+};
+
+/*
+ * ----------------------------------------------------------------------------
+ * ESPboy Library
+ * ----------------------------------------------------------------------------
+ * Copyright (c) 2021-2022 Stéphane Calderoni (https://github.com/m1cr0lab)
+ * 
+ * This program is free software: you can redistribute it and/or modify
+ * it under the terms of the GNU General Public License as published by
+ * the Free Software Foundation, either version 3 of the License, or
+ * (at your option) any later version.
+ * 
+ * This program is distributed in the hope that it will be useful,
+ * but WITHOUT ANY WARRANTY; without even the implied warranty of
+ * MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE. See the
+ * GNU General Public License for more details.
+ * 
+ * You should have received a copy of the GNU General Public License
+ * along with this program. If not, see <https://www.gnu.org/licenses/>.
+ * ----------------------------------------------------------------------------
+ */
\ No newline at end of file
@@ -0,0 +1,360 @@
+/**
+ * ----------------------------------------------------------------------------
+ * @file   Game2048.cpp
+ * @author Stéphane Calderoni (https://github.com/m1cr0lab)
+ * @brief  Bitboard engine for the 2048 puzzle, with an expectimax player
+ * ----------------------------------------------------------------------------
+ */
+
+#include "Game2048.h"
+
+constexpr Game2048::_RowTable Game2048::_ROWS PROGMEM;
+
+Game2048::Game2048()
+: _board(0)
+, _fours(0)
+, _moves(0)
+, _budget(0)
+, _nodes(0)
+, _depth(0)
+, _aborted(false)
+{}
+
+void Game2048::start(Random &rng) {
+
+    clear();
+    spawn(rng);
+    spawn(rng);
+
+}
+
+void Game2048::clear() {
+
+    _board = 0;
+    _fours = _moves = 0;
+
+}
+
+uint8_t Game2048::tile(uint8_t const row, uint8_t const col) const {
+
+    return _board >> (((row << 2) + col) << 2) & 0xf;
+
+}
+
+void Game2048::set(uint8_t const row, uint8_t const col, uint8_t const tile) {
+
+    uint8_t const shift = ((row << 2) + col) << 2;
+
+    _board = (_board & ~((uint64_t)0xf << shift)) | (uint64_t)(tile & 0xf) << shift;
+
+}
+
+uint64_t Game2048::board() const { return _board; }
+uint32_t Game2048::score() const { return _tileScore(_board) - (_fours << 2); }
+uint32_t Game2048::moves() const { return _moves; }
+uint8_t  Game2048::empty() const { return _empty(_board); }
+uint8_t  Game2048::depth() const { return _depth; }
+uint32_t Game2048::nodes() const { return _nodes; }
+
+uint8_t Game2048::highest() const {
+
+    uint8_t high = 0;
+
+    for (uint64_t b = _board; b; b >>= 4) if ((b & 0xf) > high) high = b & 0xf;
+
+    return high;
+
+}
+
+bool Game2048::over() const {
+
+    for (uint8_t dir = 0; dir < 4; ++dir) if (_slide(_board, dir) != _board) return false;
+
+    return true;
+
+}
+
+bool Game2048::move(uint8_t const dir) {
+
+    if (dir > DOWN) return false;
+
+    uint64_t const board = _slide(_board, dir);
+
+    if (board == _board) return false;
+
+    _board = board;
+    _moves++;
+
+    return true;
+
+}
+
+bool Game2048::spawn(Random &rng) {
+
+    uint8_t n = _empty(_board);
+
+    if (!n) return false;
+
+    n = rng.below(n);
+
+    uint8_t const tile = rng.below(10) ? 1 : 2;
+    if (tile == 2) _fours++;
+
+    for (uint8_t shift = 0;; shift += 4) {
+        if (_board >> shift & 0xf) continue;
+        if (!n--) { _board |= (uint64_t)tile << shift; break; }
+    }
+
+    return true;
+
+}
+
+bool Game2048::play(uint8_t const dir, Random &rng) {
+
+    if (!move(dir)) return false;
+
+    spawn(rng);
+
+    return true;
+
+}
+
+uint8_t Game2048::hint(uint32_t const budget) {
+
+    uint8_t best = NO_MOVE;
+
+    // the first depth examines 4 positions at most, and is always completed
+    // so that a live board gets a move, whatever the budget
+    _budget = budget < 4 ? 4 : budget;
+    _nodes  = 0;
+    _depth  = 0;
+
+    for (uint8_t depth = 1; depth <= _MAX_DEPTH; ++depth) {
+
+        int32_t value     = _LOST;
+        uint8_t best_here = NO_MOVE;
+
+        _aborted = false;
+
+        for (uint8_t dir = 0; dir < 4; ++dir) {
+
+            uint64_t const board = _slide(_board, dir);
+            if (board == _board) continue;
+
+            int32_t const v = _chance(board, depth - 1, _ONE);
+            if (_aborted) break;
+
+            if (best_here == NO_MOVE || v > value) { value = v; best_here = dir; }
+
+        }
+
+        // an unfinished search is not trusted
+        if (_aborted) break;
+
+        best   = best_here;
+        _depth = depth;
+
+        if (best == NO_MOVE) break;
+
+    }
+
+    return best;
+
+}
+
+int32_t Game2048::_maximize(uint64_t const board, uint8_t const depth, uint32_t const prob) {
+
+    int32_t best = _LOST;
+
+    for (uint8_t dir = 0; dir < 4; ++dir) {
+
+        if (++_nodes > _budget) { _aborted = true; return 0; }
+
+        uint64_t const next = _slide(board, dir);
+        if (next == board) continue;
+
+        int32_t const v = _chance(next, depth - 1, prob);
+        if (_aborted) return 0;
+
+        if (v > best) best = v;
+
+    }
+
+    return best;
+
+}
+
+int32_t Game2048::_chance(uint64_t const board, uint8_t const depth, uint32_t const prob) {
+
+    uint8_t const n = _empty(board);
+
+    if (!depth || !n || prob < _PRUNE) {
+        if (++_nodes > _budget) _aborted = true;
+        return _value(board);
+    }
+
+    // a 2 is dropped 9 times out of 10, a 4 otherwise
+    uint32_t const prob2 = prob * 9 / (10 * n);
+    uint32_t const prob4 = prob / (10 * n);
+    int64_t        sum   = 0;
+
+    for (uint8_t shift = 0; shift < 64; shift += 4) {
+
+        if (board >> shift & 0xf) continue;
+
+        sum += 9 * (int64_t)_maximize(board | (uint64_t)1 << shift, depth, prob2);
+        if (_aborted) return 0;
+
+        sum += _maximize(board | (uint64_t)2 << shift, depth, prob4);
+        if (_aborted) return 0;
+
+    }
+
+    return sum / (10 * n);
+
+}
+
+uint16_t Game2048::_reverse(uint16_t const row) {
+
+    return row >> 12 | (row >> 4 & 0x00f0) | (row << 4 & 0x0f00) | row << 12;
+
+}
+
+uint64_t Game2048::_transpose(uint64_t const board) {
+
+    // swaps the nibbles across the diagonal of each 2x2 block, then the 2x2
+    // blocks across the diagonal of the board
+    uint64_t const a = (board & 0xf0f00f0ff0f00f0f)
+                     | (board & 0x0000f0f00000f0f0) << 12
+                     | (board & 0x0f0f00000f0f0000) >> 12;
+
+    return (a & 0xff00ff0000ff00ff)
+         | (a & 0x00ff00ff00000000) >> 24
+         | (a & 0x00000000ff00ff00) << 24;
+
+}
+
+uint64_t Game2048::_slide(uint64_t const board, uint8_t const dir) {
+
+    bool     const vertical = dir & 1;
+    bool     const reverse  = dir >= RIGHT;
+    uint64_t const rows     = vertical ? _transpose(board) : board;
+    uint64_t       slid     = 0;
+
+    for (uint8_t shift = 0; shift < 64; shift += 16) {
+
+        uint16_t row = rows >> shift;
+
+        if (row) {
+            row = pgm_read_word(&_ROWS.left[reverse ? _reverse(row) : row]);
+            if (reverse) row = _reverse(row);
+        }
+
+        slid |= (uint64_t)row << shift;
+
+    }
+
+    return vertical ? _transpose(slid) : slid;
+
+}
+
+uint8_t Game2048::_empty(uint64_t const board) {
+
+    // a nibble of the result is set when the tile is empty
+    uint64_t b = board | board >> 2;
+    b |= b >> 1;
+
+    return __builtin_popcountll(~b & _NIBBLES);
+
+}
+
+uint32_t Game2048::_tileScore(uint64_t const board) {
+
+    // merging two tiles of 2^k scores 2^(k+1), which is exactly what the
+    // sum of (k - 1) * 2^k over the tiles gains: the score can be worked out
+    // from the board, once the 4s dropped by the game are taken off
+    uint32_t score = 0;
+
+    for (uint64_t b = board; b; b >>= 4) {
+        uint8_t const k = b & 0xf;
+        if (k > 1) score += (k - 1) << k;
+    }
+
+    return score;
+
+}
+
+int32_t Game2048::_rowValue(uint16_t const row) {
+
+    uint8_t t[4];
+    for (uint8_t j = 0; j < 4; ++j) t[j] = row >> (j << 2) & 0xf;
+
+    int32_t empty  = 0;
+    int32_t merges = 0;
+    int32_t sum    = 0;
+    uint8_t prev   = 0;
+    uint8_t equal  = 0;
+
+    for (uint8_t j = 0; j < 4; ++j) {
+
+        sum += t[j] * t[j] * t[j];
+
+        if (!t[j]) { empty++; continue; }
+
+        if (t[j] == prev) equal++;
+        else if (equal) { merges += 1 + equal; equal = 0; }
+
+        prev = t[j];
+
+    }
+
+    if (equal) merges += 1 + equal;
+
+    // big tiles should line up in order towards one side
+    int32_t mono_left  = 0;
+    int32_t mono_right = 0;
+
+    for (uint8_t j = 1; j < 4; ++j) {
+        int32_t const a = t[j - 1] * t[j - 1] * t[j - 1] * t[j - 1];
+        int32_t const b = t[j]     * t[j]     * t[j]     * t[j];
+        if (a > b) mono_left += a - b; else mono_right += b - a;
+    }
+
+    return _EMPTY_WEIGHT * empty
+         + _MERGE_WEIGHT * merges
+         - _MONO_WEIGHT  * (mono_left < mono_right ? mono_left : mono_right)
+         - _SUM_WEIGHT   * sum;
+
+}
+
+int32_t Game2048::_value(uint64_t const board) {
+
+    uint64_t const cols  = _transpose(board);
+    int32_t        value = 0;
+
+    for (uint8_t shift = 0; shift < 64; shift += 16) value += _rowValue(board >> shift) + _rowValue(cols >> shift);
+
+    return value;
+
+}
+
+/*
+ * ----------------------------------------------------------------------------
+ * ESPboy Library
+ * ----------------------------------------------------------------------------
+ * Copyright (c) 2021-2022 Stéphane Calderoni (https://github.com/m1cr0lab)
+ * 
+ * This program is free software: you can redistribute it and/or modify
+ * it under the terms of the GNU General Public License as published by
+ * the Free Software Foundation, either version 3 of the License, or
+ * (at your option) any later version.
+ * 
+ * This program is distributed in the hope that it will be useful,
+ * but WITHOUT ANY WARRANTY; without even the implied warranty of
+ * MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE. See the
+ * GNU General Public License for more details.
+ * 
+ * You should have received a copy of the GNU General Public License
+ * along with this program. If not, see <https://www.gnu.org/licenses/>.
+ * ----------------------------------------------------------------------------
+ */
\ No newline at end of file
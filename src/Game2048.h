@@ -0,0 +1,234 @@
+/**
+ * ----------------------------------------------------------------------------
+ * @file   Game2048.h
+ * @author Stéphane Calderoni (https://github.com/m1cr0lab)
+ * @brief  Bitboard engine for the 2048 puzzle, with an expectimax player
+ * ----------------------------------------------------------------------------
+ */
+
+#pragma once
+
+#include <Arduino.h>
+#include "Random.h"
+
+/**
+ * @brief This class plays 2048 on a board packed into a 64-bit word, and
+ *        searches for the best move.
+ * 
+ * @details Each tile is held by 4 bits, as the base 2 logarithm of its value
+ *          (0 for an empty cell), and each row by 16 bits: the tile in row i
+ *          and column j is the nibble 4 * j of the row 16 * i, so that the
+ *          leftmost tile comes first.
+ * 
+ *          Since a row only has 65536 states, the result of sliding any row
+ *          to the left is computed at compile time and stored in flash memory
+ *          (128 KB). A move to the right goes through the same table with the
+ *          nibbles of the row reversed, and vertical moves transpose the board
+ *          with a few masks and shifts: a whole move costs 4 lookups, instead
+ *          of sliding and merging the tiles one by one.
+ * 
+ *          hint() looks for the move with the best expected outcome with an
+ *          expectimax search: the player picks the best move, and the game
+ *          drops a 2 (9 times out of 10) or a 4 on an empty cell at random.
+ *          The search deepens one move at a time until it has examined as
+ *          many positions as its budget allows, which bounds the time it
+ *          takes on the ESP8266, and ignores the outcomes too unlikely to
+ *          matter.
+ * 
+ *            Game2048 game;
+ *            Random   rng;
+ * 
+ *            game.start(rng);
+ *            while (!game.over()) game.play(game.hint(), rng);
+ * 
+ *          A tile can't go beyond 32768 (2^15): two of them don't merge.
+ */
+class Game2048 {
+
+    public:
+
+        static uint8_t constexpr LEFT    = 0;
+        static uint8_t constexpr UP      = 1;
+        static uint8_t constexpr RIGHT   = 2;
+        static uint8_t constexpr DOWN    = 3;
+        static uint8_t constexpr NO_MOVE = 0xff;
+
+    private:
+
+        static uint8_t  constexpr _MAX_DEPTH = 8;
+        static uint32_t constexpr _ONE       = 1 << 24;      // probability of 1, in fixed point
+        static uint32_t constexpr _PRUNE     = _ONE / 10000; // outcomes less likely are not searched
+        static int32_t  constexpr _LOST      = -(1 << 28);   // value of a board without any move
+        static uint64_t constexpr _NIBBLES   = 0x1111111111111111;
+
+        // weights of the evaluation of a row
+        static int32_t constexpr _EMPTY_WEIGHT = 270;
+        static int32_t constexpr _MERGE_WEIGHT = 700;
+        static int32_t constexpr _MONO_WEIGHT  = 47;
+        static int32_t constexpr _SUM_WEIGHT   = 11;
+
+        /**
+         * @brief Slides a row to the left, merging the pairs of equal tiles.
+         */
+        static constexpr uint16_t _slideRow(uint16_t const row) {
+
+            uint8_t tile[4] {};
+            uint8_t n    = 0;
+            uint8_t last = 0; // tile that may still merge
+
+            for (uint8_t j = 0; j < 4; ++j) {
+                uint8_t const t = row >> (j << 2) & 0xf;
+                if (!t) continue;
+                if (t == last && t < 0xf) { tile[n - 1]++; last = 0; }
+                else                      { tile[n++] = t; last = t; }
+            }
+
+            return tile[0] | tile[1] << 4 | tile[2] << 8 | tile[3] << 12;
+
+        }
+
+        /**
+         * @brief Every row slid to the left.
+         */
+        struct _RowTable {
+
+            uint16_t left[0x10000] {};
+
+            constexpr _RowTable() {
+
+                for (uint32_t row = 0; row < 0x10000; ++row) left[row] = _slideRow(row);
+
+            }
+
+        };
+
+        static _RowTable const _ROWS;
+
+        uint64_t _board;
+        uint32_t _fours;  // 4s dropped by the game, which haven't been scored
+        uint32_t _moves;
+        uint32_t _budget;
+        uint32_t _nodes;
+        uint8_t  _depth;
+        bool     _aborted;
+
+        static uint16_t _reverse(uint16_t const row);
+        static uint64_t _transpose(uint64_t const board);
+        static uint64_t _slide(uint64_t const board, uint8_t const dir);
+        static uint8_t  _empty(uint64_t const board);
+        static uint32_t _tileScore(uint64_t const board);
+        static int32_t  _rowValue(uint16_t const row);
+        static int32_t  _value(uint64_t const board);
+
+        int32_t _maximize(uint64_t const board, uint8_t const depth, uint32_t const prob);
+        int32_t _chance(uint64_t const board, uint8_t const depth, uint32_t const prob);
+
+    public:
+
+        Game2048();
+
+        /**
+         * @brief Empties the board and drops two tiles on it.
+         */
+        void start(Random &rng);
+
+        /**
+         * @brief Empties the board, and resets the score and the number of moves.
+         */
+        void clear();
+
+        /**
+         * @brief Base 2 logarithm of the tile at a given position (0 for an empty cell).
+         */
+        uint8_t tile(uint8_t const row, uint8_t const col) const;
+        void    set(uint8_t const row, uint8_t const col, uint8_t const tile);
+
+        /**
+         * @brief The whole board, 4 bits per tile.
+         */
+        uint64_t board() const;
+
+        uint32_t score() const;
+        uint32_t moves() const;
+
+        /**
+         * @brief Base 2 logarithm of the highest tile.
+         */
+        uint8_t highest() const;
+
+        /**
+         * @brief Number of empty cells.
+         */
+        uint8_t empty() const;
+
+        /**
+         * @brief Whether no move is left.
+         */
+        bool over() const;
+
+        /**
+         * @brief Slides the tiles in a direction, without dropping a new one.
+         * 
+         * @param dir LEFT, UP, RIGHT or DOWN.
+         * 
+         * @return false if no tile has moved (the move is not counted).
+         */
+        bool move(uint8_t const dir);
+
+        /**
+         * @brief Drops a 2 (9 times out of 10) or a 4 on an empty cell.
+         * 
+         * @return false if the board is full.
+         */
+        bool spawn(Random &rng);
+
+        /**
+         * @brief Slides the tiles, and drops a new one if they have moved.
+         */
+        bool play(uint8_t const dir, Random &rng);
+
+        /**
+         * @brief Searches for the best move.
+         * 
+         * @param budget Number of positions the search may examine.
+         * 
+         * @return The direction of the best move, or NO_MOVE if the game is over.
+         * 
+         * @details The time taken grows linearly with the budget. The result
+         *          comes from the deepest search completed within the budget,
+         *          and a search one move deep is completed in any case.
+         */
+        uint8_t hint(uint32_t const budget = 5000);
+
+        /**
+         * @brief Depth (in moves) of the search that gave the last hint.
+         */
+        uint8_t depth() const;
+
+        /**
+         * @brief Number of positions examined by the last hint().
+         */
+        uint32_t nodes() const;
+
+};
+
+/*
+ * ----------------------------------------------------------------------------
+ * ESPboy Library
+ * ----------------------------------------------------------------------------
+ * Copyright (c) 2021-2022 Stéphane Calderoni (https://github.com/m1cr0lab)
+ * 
+ * This program is free software: you can redistribute it and/or modify
+ * it under the terms of the GNU General Public License as published by
+ * the Free Software Foundation, either version 3 of the License, or
+ * (at your option) any later version.
+ * 
+ * This program is distributed in the hope that it will be useful,
+ * but WITHOUT ANY WARRANTY; without even the implied warranty of
+ * MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE. See the
+ * GNU General Public License for more details.
+ * 
+ * You should have received a copy of the GNU General Public License
+ * along with this program. If not, see <https://www.gnu.org/licenses/>.
+ * ----------------------------------------------------------------------------
+ */
\ No newline at end of file
@@ -0,0 +1,805 @@
+/**
+ * ----------------------------------------------------------------------------
+ * @file   HAL.h
+ * @author Stéphane Calderoni (https://github.com/m1cr0lab)
+ * @brief  Hardware abstraction layer
+ * 
+ * @details The ESPboy peripherals are reached through a handful of thin
+ *          classes gathered in the `hal` namespace:
+ * 
+ *            hal::Clock    time base (millis, micros, CPU cycles)
+ *            hal::Reset    cause of the last reset
+ *            hal::Expander MCP23017 I/O expander (push buttons, locks)
+ *            hal::Dac      MCP4725 DAC (screen backlight)
+ *            hal::LedLine  NeoPixel data line
+ *            hal::Display  TFT display
+ *            hal::Sprite   offscreen drawing surface
+ *            hal::AsyncBlit background transfer of pixels to the display
+ * 
+ *          On the ESP8266 they are backed by the actual drivers. Anywhere
+ *          else (typically a Linux dev box), they are replaced by stand-ins
+ *          that record I2C transactions, DAC writes, LED frames and pushed
+ *          pixels into memory, so that the library can be compiled,
+ *          profiled and benchmarked off-device (see extras/host).
+ * ----------------------------------------------------------------------------
+ */
+
+#pragma once
+
+#include <Arduino.h>
+
+#if defined(ARDUINO_ARCH_ESP8266)
+    #define ESPBOY_HAL_ESP8266
+#else
+    #define ESPBOY_HAL_HOST
+#endif
+
+#if defined(ESPBOY_HAL_ESP8266)
+
+    #define LGFX_ESPBOY
+    #define LGFX_USE_V1
+    #include <LovyanGFX.hpp>
+    #include <LGFX_AUTODETECT.hpp>
+
+    #include <Adafruit_MCP23X17.h>
+    #include <Adafruit_MCP4725.h>
+
+#else
+
+    #include <atomic>
+    #include <condition_variable>
+    #include <mutex>
+    #include <thread>
+
+#endif
+
+namespace hal {
+
+/**
+ * @brief Fixed-capacity ring buffer keeping the most recent records
+ *        of a host stand-in, without any allocation on the hot path.
+ */
+template <typename T, uint16_t N>
+class Log {
+
+    private:
+
+        T        _records[N];
+        uint32_t _count = 0;
+
+    public:
+
+        void push(T const &record) { _records[_count++ % N] = record; }
+        void clear() { _count = 0; }
+
+        /**
+         * @brief Total number of records pushed since the last clear().
+         */
+        uint32_t count() const { return _count; }
+
+        /**
+         * @brief Number of records still available (at most N).
+         */
+        uint16_t size() const { return _count < N ? _count : N; }
+
+        /**
+         * @brief Returns the i-th oldest available record.
+         */
+        T const &operator[](uint16_t const i) const { return _records[(_count - size() + i) % N]; }
+
+        /**
+         * @brief Returns the most recent record (the log must not be empty).
+         */
+        T const &last() const { return _records[(_count - 1) % N]; }
+
+};
+
+/**
+ * @brief Time base.
+ */
+class Clock {
+
+    public:
+
+        static uint32_t ms();
+        static uint32_t us();
+
+        /**
+         * @brief Free-running CPU cycle counter (80 or 160 MHz on the ESP8266,
+         *        emulated at F_CPU on the host).
+         */
+        static uint32_t cycles();
+
+        #if defined(ESPBOY_HAL_HOST)
+
+        /**
+         * @brief Switches the host clock between wall-clock time and a virtual
+         *        time that only moves forward through advance() and delay().
+         * 
+         * @details Virtual time makes headless runs deterministic and lets
+         *          them run unthrottled.
+         */
+        static void useVirtualTime(bool const enabled);
+        static void advance(uint32_t const us);
+
+        #endif
+
+};
+
+/**
+ * @brief Cause of the last reset.
+ */
+class Reset {
+
+    public:
+
+        /**
+         * @brief Whether the chip has just woken up from deep sleep.
+         */
+        static bool fromDeepSleep();
+
+        #if defined(ESPBOY_HAL_HOST)
+
+        /**
+         * @brief Makes the host pretend to wake up from deep sleep (or not).
+         */
+        static void simulateDeepSleep(bool const enabled);
+
+        #endif
+
+};
+
+#if defined(ESPBOY_HAL_ESP8266)
+
+inline bool Reset::fromDeepSleep() { return ESP.getResetInfoPtr()->reason == REASON_DEEP_SLEEP_AWAKE; }
+
+inline uint32_t Clock::ms()     { return millis(); }
+inline uint32_t Clock::us()     { return micros(); }
+inline uint32_t Clock::cycles() { return ESP.getCycleCount(); }
+
+#endif
+
+/**
+ * @brief Bookkeeping of the traffic on the I2C bus, shared by the expander
+ *        and the DAC.
+ * 
+ * @details Byte counts include the address, register and data bytes of each
+ *          transaction, as they appear on the wire.
+ */
+class I2CCounter {
+
+    protected:
+
+        uint32_t _i2c_bytes        = 0;
+        uint32_t _i2c_transactions = 0;
+
+        void _count(uint8_t const bytes) { _i2c_bytes += bytes; _i2c_transactions++; }
+
+    public:
+
+        uint32_t i2cBytes()        const { return _i2c_bytes;        }
+        uint32_t i2cTransactions() const { return _i2c_transactions; }
+
+};
+
+/**
+ * @brief A record of the host I2C stand-ins.
+ */
+struct I2CTransaction {
+
+    uint32_t us;      // timestamp
+    uint8_t  address; // 7-bit device address
+    uint8_t  reg;     // register or command
+    uint8_t  length;  // number of data bytes
+    bool     read;    // true for a read, false for a write
+    uint16_t data;    // data read or written
+
+};
+
+#if defined(ESPBOY_HAL_ESP8266)
+
+/**
+ * @brief MCP23017 I/O expander.
+ * 
+ * @details Extends the Adafruit driver, so that its whole API remains
+ *          available, and accounts for the I2C traffic of the methods
+ *          used by the library.
+ */
+class Expander : public Adafruit_MCP23X17, public I2CCounter {
+
+    private:
+
+        bool _armed = false;
+
+    public:
+
+        bool begin(uint8_t const address = MCP23XXX_ADDR);
+
+        void     pinMode(uint8_t const pin, uint8_t const mode);
+        void     digitalWrite(uint8_t const pin, uint8_t const value);
+        uint8_t  readGPIOA();
+        uint16_t readGPIOAB();
+
+        /**
+         * @brief Arms the interrupt-on-change of the Port A pins selected by mask.
+         * 
+         * @param mask    Port A pins to watch.
+         * @param int_pin ESP8266 GPIO wired to the INTA output of the MCP23017.
+         * 
+         * @details Once armed, changed() tells whether a watched pin has changed
+         *          since the last read of Port A, without any I2C transaction.
+         */
+        void armInterruptOnChange(uint8_t const mask, uint8_t const int_pin);
+
+        /**
+         * @brief Checks if Port A may have changed since it was last read.
+         * 
+         * @return Always true until armInterruptOnChange() has been called.
+         */
+        bool changed() const;
+
+        /**
+         * @brief Time in microseconds of the last interrupt-on-change.
+         */
+        uint32_t changedAt() const;
+
+};
+
+/**
+ * @brief MCP4725 DAC.
+ */
+class Dac : public Adafruit_MCP4725, public I2CCounter {
+
+    private:
+
+        uint8_t _address;
+
+    public:
+
+        bool begin(uint8_t const address);
+        bool setVoltage(uint16_t const output, bool const writeEEPROM);
+
+        /**
+         * @brief Sets the output with the fast mode command of the MCP4725
+         *        (2 data bytes, no EEPROM), instead of the 3-byte write command.
+         */
+        bool fastWrite(uint16_t const output);
+
+};
+
+/**
+ * @brief Display controller (LovyanGFX driver).
+ */
+using Display = LGFX;
+
+/**
+ * @brief Offscreen drawing surface (LovyanGFX sprite).
+ */
+using Sprite = LGFX_Sprite;
+
+#else // ESPBOY_HAL_HOST
+
+/**
+ * @brief Host stand-in of the MCP23017 I/O expander.
+ * 
+ * @details Models the IODIR, GPPU, GPIO and OLAT registers and records
+ *          every transaction. Buttons are simulated with setButtons().
+ */
+class Expander : public I2CCounter {
+
+    private:
+
+        uint8_t  _address;
+        uint16_t _iodir = 0xffff;
+        uint16_t _gppu  = 0x0000;
+        uint16_t _olat  = 0x0000;
+        uint16_t _input = 0xffff;
+        uint8_t  _gpinten = 0x00;
+        bool     _int_pending = false;
+        uint32_t _int_us = 0;
+
+        void _record(uint8_t const reg, uint8_t const length, bool const read, uint16_t const data);
+
+    public:
+
+        Log<I2CTransaction, 256> transactions;
+
+        bool begin(uint8_t const address = 0x20);
+
+        void     pinMode(uint8_t const pin, uint8_t const mode);
+        void     digitalWrite(uint8_t const pin, uint8_t const value);
+        uint8_t  digitalRead(uint8_t const pin);
+        uint8_t  readGPIOA();
+        uint16_t readGPIOAB();
+
+        /**
+         * @brief Arms the interrupt-on-change of the Port A pins selected by mask.
+         * 
+         * @param mask    Port A pins to watch.
+         * @param int_pin ESP8266 GPIO wired to the INTA output of the MCP23017.
+         * 
+         * @details Once armed, changed() tells whether a watched pin has changed
+         *          since the last read of Port A, without any I2C transaction.
+         */
+        void armInterruptOnChange(uint8_t const mask, uint8_t const int_pin);
+
+        /**
+         * @brief Checks if Port A may have changed since it was last read.
+         * 
+         * @return Always true until armInterruptOnChange() has been called.
+         */
+        bool changed() const;
+
+        /**
+         * @brief Time in microseconds of the last interrupt-on-change.
+         */
+        uint32_t changedAt() const;
+
+        /**
+         * @brief Simulates the push buttons wired to Port A.
+         * 
+         * @param pressed A bitmask of the buttons held down (PAD_* constants).
+         */
+        void setButtons(uint8_t const pressed);
+
+        /**
+         * @brief Current state of the output latches.
+         */
+        uint16_t outputs() const { return _olat; }
+
+};
+
+/**
+ * @brief A record of the host DAC stand-in.
+ */
+struct DacWrite {
+
+    uint32_t us;
+    uint16_t value;
+    bool     eeprom;
+    bool     fast;
+
+};
+
+/**
+ * @brief Host stand-in of the MCP4725 DAC.
+ */
+class Dac : public I2CCounter {
+
+    private:
+
+        uint8_t  _address;
+        uint16_t _value = 0;
+
+    public:
+
+        Log<DacWrite, 256> writes;
+
+        bool begin(uint8_t const address);
+        bool setVoltage(uint16_t const output, bool const writeEEPROM);
+        bool fastWrite(uint16_t const output);
+
+        uint16_t value() const { return _value; }
+
+};
+
+/**
+ * @brief Host stand-in of a LovyanGFX drawing surface.
+ * 
+ * @details Implements the subset of the LovyanGFX API used by the library
+ *          on top of an in-memory RGB565 buffer (or a packed buffer of palette
+ *          indexes for 1, 2, 4 and 8-bit sprites), and counts the pixels it
+ *          writes. Text is not rasterized: it is only accounted for in
+ *          textCalls(), with a 6x8 pixel font metric.
+ */
+class Canvas {
+
+    protected:
+
+        uint16_t *_buffer = nullptr;
+        int32_t   _width  = 0;
+        int32_t   _height = 0;
+        uint8_t   _bpp    = 16;
+
+        int32_t _clip_x = 0, _clip_y = 0, _clip_w = 0, _clip_h = 0;
+
+        uint32_t _written_pixels = 0;
+        uint32_t _text_calls     = 0;
+        uint16_t _text_color     = 0xffff;
+        uint8_t  _text_datum     = 0;
+
+        void _attach(uint16_t * const buffer, int32_t const width, int32_t const height);
+        void _write(int32_t const x, int32_t const y, uint16_t const color);
+        void _text(char const *text) { _text_calls++; }
+
+    public:
+
+        int32_t width()  const { return _width;  }
+        int32_t height() const { return _height; }
+
+        void startWrite() {}
+        void endWrite()   {}
+
+        void setClipRect(int32_t const x, int32_t const y, int32_t const w, int32_t const h);
+        void clearClipRect() { setClipRect(0, 0, _width, _height); }
+
+        void drawPixel(int32_t const x, int32_t const y, uint16_t const color) { _write(x, y, color); }
+        void drawFastHLine(int32_t const x, int32_t const y, int32_t const w, uint16_t const color) { fillRect(x, y, w, 1, color); }
+        void drawFastVLine(int32_t const x, int32_t const y, int32_t const h, uint16_t const color) { fillRect(x, y, 1, h, color); }
+        void drawRect(int32_t const x, int32_t const y, int32_t const w, int32_t const h, uint16_t const color);
+        void fillRect(int32_t const x, int32_t const y, int32_t const w, int32_t const h, uint16_t const color);
+        void fillRoundRect(int32_t const x, int32_t const y, int32_t const w, int32_t const h, int32_t const, uint16_t const color) { fillRect(x, y, w, h, color); }
+        void fillScreen(uint16_t const color) { fillRect(0, 0, _width, _height, color); }
+        void clear(uint16_t const color = 0) { fillScreen(color); }
+
+        void drawBitmap(int32_t const x, int32_t const y, uint8_t const *bitmap, int32_t const w, int32_t const h, uint16_t const color);
+        void pushImage(int32_t const x, int32_t const y, int32_t const w, int32_t const h, uint16_t const *data);
+        void pushImage(int32_t const x, int32_t const y, int32_t const w, int32_t const h, uint16_t const *data, uint16_t const transparent);
+
+        void setTextColor(uint16_t const color) { _text_color = color; }
+        void setTextColor(uint16_t const fg, uint16_t const) { _text_color = fg; }
+        void setTextDatum(uint8_t const datum) { _text_datum = datum; }
+        void drawString(char const *text, int32_t const, int32_t const) { _text(text); }
+        void drawString(__FlashStringHelper const *text, int32_t const, int32_t const) { _text((char const *)text); }
+        void drawCenterString(char const *text, int32_t const, int32_t const) { _text(text); }
+        void drawCenterString(__FlashStringHelper const *text, int32_t const, int32_t const) { _text((char const *)text); }
+        void drawNumber(long const, int32_t const, int32_t const) { _text(nullptr); }
+
+        int32_t textWidth(char const *text) const { return 6 * strlen(text); }
+        int32_t fontHeight() const { return 8; }
+
+        void    *getBuffer() const { return _buffer; }
+        uint16_t pixel(int32_t const x, int32_t const y) const;
+
+        uint32_t textCalls() const { return _text_calls; }
+
+};
+
+/**
+ * @brief Host stand-in of the TFT display.
+ * 
+ * @details Keeps the screen content in memory and counts the pixels pushed
+ *          to it, which stands for the SPI traffic (2 bytes per pixel).
+ */
+class Display : public Canvas {
+
+    public:
+
+        static uint8_t constexpr WIDTH  = 128;
+        static uint8_t constexpr HEIGHT = 128;
+
+    private:
+
+        uint16_t _pixels[WIDTH * HEIGHT];
+        uint8_t  _brightness  = 0;
+        uint8_t  _scroll_line = 0;
+
+        int32_t _win_x, _win_y, _win_w, _win_h, _win_i;
+
+    public:
+
+        Display() { _attach(_pixels, WIDTH, HEIGHT); }
+
+        void init();
+        void setBrightness(uint8_t const brightness) { _brightness = brightness; }
+
+        void setAddrWindow(int32_t const x, int32_t const y, int32_t const w, int32_t const h);
+        void writePixels(uint16_t const *data, int32_t const length, bool const swap = true);
+
+        uint16_t const *pixels() const { return _pixels; }
+        uint8_t  brightness() const { return _brightness; }
+
+        void    setScrollLine(uint8_t const line) { _scroll_line = line & (HEIGHT - 1); }
+        uint8_t scrollLine() const { return _scroll_line; }
+
+        /**
+         * @brief Pixel seen at (x, y) on the screen, once the memory rows have been scrolled.
+         */
+        uint16_t shown(int32_t const x, int32_t const y) const { return pixel(x, (y + _scroll_line) & (HEIGHT - 1)); }
+
+        /**
+         * @brief Total number of pixels sent to the screen since the last resetStats().
+         */
+        uint32_t pushedPixels() const { return _written_pixels; }
+        void     resetStats() { _written_pixels = _text_calls = 0; }
+
+};
+
+/**
+ * @brief Host stand-in of an LGFX_Sprite.
+ * 
+ * @details With a color depth of 8 bits or less, the sprite holds palette
+ *          indexes packed like LovyanGFX does (leftmost pixel in the most
+ *          significant bits), and can't be pushed to the display as is.
+ */
+class Sprite : public Canvas {
+
+    private:
+
+        Display *_parent;
+
+    public:
+
+        Sprite(Display * const parent = nullptr) : _parent(parent) {}
+        ~Sprite() { deleteSprite(); }
+
+        void  setColorDepth(uint8_t const bpp) { _bpp = bpp; }
+        bool  createPalette() { return _bpp <= 8; }
+        void *createSprite(int32_t const w, int32_t const h);
+        void  deleteSprite();
+
+        void fillSprite(uint16_t const color) { fillScreen(color); }
+
+        void pushSprite(int32_t const x, int32_t const y) { pushSprite(_parent, x, y); }
+        void pushSprite(Display * const dst, int32_t const x, int32_t const y) { dst->pushImage(x, y, _width, _height, _buffer); }
+
+};
+
+uint16_t constexpr TFT_BLACK     = 0x0000;
+uint16_t constexpr TFT_DARKGRAY  = 0x7bef;
+uint16_t constexpr TFT_LIGHTGRAY = 0xd69a;
+uint16_t constexpr TFT_WHITE     = 0xffff;
+uint16_t constexpr TFT_YELLOW    = 0xffe0;
+
+/**
+ * @brief Text datums, as LovyanGFX exposes them to the sketches.
+ */
+namespace textdatum {
+
+enum textdatum_t : uint8_t {
+
+    top_left    = 0, top_center    = 1, top_right    = 2,
+    middle_left = 4, middle_center = 5, middle_right = 6,
+    bottom_left = 8, bottom_center = 9, bottom_right = 10
+
+};
+
+}
+
+#endif
+
+/**
+ * @brief Color depth of a sprite holding palette indexes.
+ */
+#if defined(ESPBOY_HAL_ESP8266)
+inline lgfx::color_depth_t paletteDepth(uint8_t const bpp) { return (lgfx::color_depth_t)(bpp | lgfx::color_depth_t::has_palette); }
+#else
+inline uint8_t paletteDepth(uint8_t const bpp) { return bpp; }
+#endif
+
+/**
+ * @brief Converts an RGB565 color to the layout of the pixels sent to the display:
+ *        big-endian on the ESP8266, as LovyanGFX sprites store them, and native
+ *        in the host stand-ins.
+ */
+inline uint16_t constexpr displayOrder(uint16_t const color) {
+
+    #if defined(ESPBOY_HAL_ESP8266)
+    return color >> 8 | color << 8;
+    #else
+    return color;
+    #endif
+
+}
+
+/**
+ * @brief Sets the memory row shown at the top of the screen, with the vertical
+ *        scrolling registers of the ST7735 controller.
+ * 
+ * @details The rows scrolled out of one edge of the screen reappear at the
+ *          other edge, so that a scrolling view only has to draw the rows
+ *          it exposes.
+ * 
+ * @return false if the display can't scroll in its current orientation.
+ */
+bool scrollDisplay(Display &tft, uint8_t const line);
+
+/**
+ * @brief NeoPixel data line.
+ * 
+ * @details Sends a 24-bit GRB frame to the LED at 800 kHz without blocking.
+ *          The LED is wired to GPIO2, which is also the TX line of UART1:
+ *          the ESP8266 implementation drives it with the UART at 3.2 Mbaud,
+ *          each 8-bit UART symbol (start bit, 6 data bits, stop bit, inverted)
+ *          encoding 2 bits of the frame. The 12 symbols of a frame are pushed
+ *          into the 128-byte UART FIFO and shifted out by the hardware, with
+ *          interrupts left enabled. The host stand-in records the frames and
+ *          the waveform, i.e. the UART symbols that would be sent.
+ */
+class LedLine {
+
+    private:
+
+        // UART symbols for each pair of bits, once inverted on the wire:
+        // 00 => 1000 1000, 01 => 1000 1110, 10 => 1110 1000, 11 => 1110 1110
+        static uint8_t constexpr _SYMBOL[] = { 0b110111, 0b000111, 0b110100, 0b000100 };
+
+        static uint8_t  constexpr _FRAME_US = 30;  // 12 symbols of 8 bits at 3.2 Mbaud
+        static uint16_t constexpr _LATCH_US = 300; // low time after which the LED latches a frame (280 us at least)
+
+        uint8_t  _pin;
+        uint32_t _sent_us = 0; // time at which the last frame was sent
+
+    public:
+
+        static uint8_t constexpr SYMBOLS_PER_FRAME = 12;
+
+        #if defined(ESPBOY_HAL_HOST)
+        Log<uint32_t, 256> frames;
+        Log<uint8_t, 256 * SYMBOLS_PER_FRAME> waveform;
+        #endif
+
+        /**
+         * @brief Returns the UART symbol encoding the i-th pair of bits of a frame.
+         */
+        static constexpr uint8_t symbol(uint32_t const color, uint8_t const i) {
+
+            return _SYMBOL[color >> (22 - (i << 1)) & 0x3];
+
+        }
+
+        void begin(uint8_t const pin);
+
+        /**
+         * @brief Hands the line over to the UART (idle low), which lights
+         *        the onboard LED on the D1 mini.
+         */
+        void open();
+
+        /**
+         * @brief Waits for the end of the transmission and drives the line
+         *        high, which turns off the onboard LED.
+         */
+        void close();
+
+        /**
+         * @brief Queues a frame for transmission and returns immediately.
+         * 
+         * @param color Frame in GRB888 format => 0x00GGRRBB
+         * 
+         * @details The LED only latches a frame once the line has stayed low
+         *          for 280 us: a frame sent any sooner would be passed on to
+         *          a next LED. When the previous frame was sent less than
+         *          300 us ago, the remaining time is waited first.
+         */
+        void write(uint32_t const color);
+
+        /**
+         * @brief Whether a frame is still being sent (about 30 us per frame).
+         */
+        bool busy() const;
+
+        /**
+         * @brief Waits for the end of the transmission.
+         */
+        void flush() const;
+
+};
+
+/**
+ * @brief Background transfer of a pixel buffer to the display.
+ * 
+ * @details The SPI controller of the ESP8266 has no DMA, but it has a 64-byte
+ *          FIFO and raises an interrupt once the FIFO has been sent: the
+ *          transfer is carried on by an interrupt handler that refills it,
+ *          so that the CPU is only taken for a few cycles every 64 bytes.
+ *          The host stand-in performs the transfer in a thread, at the pace
+ *          of a 40 MHz SPI bus, or at once in virtual time.
+ * 
+ *          The pixels must be in the byte order of the display, as they are
+ *          in a sprite. Neither the buffer nor the display may be touched
+ *          until finish() has returned. The renderers built on it (DoubleBuffer,
+ *          PaletteBuffer, StripRenderer) return while their last transfer is
+ *          still in progress: their wait() must be called before the display
+ *          is used directly.
+ */
+class AsyncBlit {
+
+    private:
+
+        Display        *_tft      = nullptr;
+        bool            _writing  = false;
+        uint16_t const *_streamed = nullptr; // band sent last by stream()
+
+        #if defined(ESPBOY_HAL_HOST)
+        static uint32_t constexpr _SPI_HZ = 40000000;
+
+        std::thread             _worker;
+        std::mutex              _mutex;
+        std::condition_variable _wake;
+        std::atomic<bool>       _busy { false };
+        bool                    _pending = false;
+        bool                    _quit    = false;
+
+        uint16_t const *_data;
+        int32_t         _x, _y, _w, _h;
+
+        void _run();
+        #endif
+
+    public:
+
+        ~AsyncBlit();
+
+        void begin(Display &tft);
+
+        /**
+         * @brief Starts sending a w x h block of pixels to the display at (x, y).
+         * 
+         * @details Waits for the completion of the previous transfer first.
+         */
+        void start(uint16_t const *data, int32_t const x, int32_t const y, int32_t const w, int32_t const h);
+
+        /**
+         * @brief Sends a w x h block of pixels to the top of the display band
+         *        by band, each band being filled while the previous one is sent.
+         * 
+         * @param band Two buffers of w x rows pixels, used in turn.
+         * @param rows Height of a band, which must divide h.
+         * @param fill Called as fill(i, y) to fill band[i] with the rows from y.
+         * 
+         * @details A buffer is never filled while it is still being sent, even
+         *          when the display fits in a single band. The last band is
+         *          still being sent on return.
+         */
+        template <typename Fill>
+        void stream(uint16_t * const band[2], int32_t const w, int32_t const h, uint8_t const rows, Fill const &fill) {
+
+            uint8_t i = 0;
+
+            for (int32_t y = 0; y < h; y += rows, i ^= 1) {
+
+                // the other band may still be on its way meanwhile, but not this one
+                if (band[i] == _streamed) finish();
+
+                fill(i, y);
+                start(_streamed = band[i], 0, y, w, rows);
+
+            }
+
+        }
+
+        /**
+         * @brief Tells whether a transfer is still in progress.
+         */
+        bool busy() const;
+
+        /**
+         * @brief Waits for the completion of the transfer and releases the display.
+         */
+        void finish();
+
+};
+
+}
+
+#if defined(ESPBOY_HAL_HOST)
+using hal::TFT_BLACK;
+using hal::TFT_DARKGRAY;
+using hal::TFT_LIGHTGRAY;
+using hal::TFT_WHITE;
+using hal::TFT_YELLOW;
+using namespace hal::textdatum;
+using LGFX_Sprite = hal::Sprite;
+#endif
+
+/*
+ * ----------------------------------------------------------------------------
+ * ESPboy Library
+ * ----------------------------------------------------------------------------
+ * Copyright (c) 2021-2022 Stéphane Calderoni (https://github.com/m1cr0lab)
+ * 
+ * This program is free software: you can redistribute it and/or modify
+ * it under the terms of the GNU General Public License as published by
+ * the Free Software Foundation, either version 3 of the License, or
+ * (at your option) any later version.
+ * 
+ * This program is distributed in the hope that it will be useful,
+ * but WITHOUT ANY WARRANTY; without even the implied warranty of
+ * MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE. See the
+ * GNU General Public License for more details.
+ * 
+ * You should have received a copy of the GNU General Public License
+ * along with this program. If not, see <https://www.gnu.org/licenses/>.
+ * ----------------------------------------------------------------------------
+ */
\ No newline at end of file
@@ -0,0 +1,329 @@
+/**
+ * ----------------------------------------------------------------------------
+ * @file   HAL_ESP8266.cpp
+ * @author Stéphane Calderoni (https://github.com/m1cr0lab)
+ * @brief  Hardware abstraction layer (ESP8266 implementation)
+ * ----------------------------------------------------------------------------
+ */
+
+#include "HAL.h"
+
+#if defined(ESPBOY_HAL_ESP8266)
+
+namespace hal {
+
+// ----------------------------------------------------------------------------
+// MCP23017 I/O expander
+// ----------------------------------------------------------------------------
+
+/**
+ * @note I2C cost of the Adafruit driver primitives:
+ *       - register write:  [addr+W] [reg] [data]                 => 3 bytes
+ *       - register read:   [addr+W] [reg] [addr+R] [data]        => 4 bytes
+ *       - register bit:    read then write (read-modify-write)   => 7 bytes
+ *       - 16-bit read:     [addr+W] [reg] [addr+R] [data] [data] => 5 bytes
+ */
+
+bool Expander::begin(uint8_t const address) { return Adafruit_MCP23X17::begin_I2C(address); }
+
+void Expander::pinMode(uint8_t const pin, uint8_t const mode) {
+
+    // IODIR and GPPU bits are both updated
+    _count(7); _count(7);
+    Adafruit_MCP23X17::pinMode(pin, mode);
+
+}
+
+void Expander::digitalWrite(uint8_t const pin, uint8_t const value) {
+
+    _count(7);
+    Adafruit_MCP23X17::digitalWrite(pin, value);
+
+}
+
+static volatile bool     _mcp_int_flag = true;
+static volatile uint32_t _mcp_int_us   = 0;
+
+static void IRAM_ATTR _onExpanderInterrupt() {
+
+    _mcp_int_us   = micros();
+    _mcp_int_flag = true;
+
+}
+
+uint8_t Expander::readGPIOA() {
+
+    // reading GPIOA clears the pending interrupt of the MCP23017,
+    // so any change occurring from now on will raise a new one
+    _mcp_int_flag = false;
+    _count(4);
+    return Adafruit_MCP23X17::readGPIOA();
+
+}
+
+uint16_t Expander::readGPIOAB() {
+
+    _mcp_int_flag = false;
+    _count(5);
+    return Adafruit_MCP23X17::readGPIOAB();
+
+}
+
+void Expander::armInterruptOnChange(uint8_t const mask, uint8_t const int_pin) {
+
+    // INTA active low, push-pull, not mirrored
+    _count(7);
+    Adafruit_MCP23X17::setupInterrupts(false, false, LOW);
+
+    for (uint8_t i = 0; i < 8; ++i) {
+        if (mask & (1 << i)) {
+            // INTCON and GPINTEN bits
+            _count(7); _count(7);
+            Adafruit_MCP23X17::setupInterruptPin(i, CHANGE);
+        }
+    }
+
+    ::pinMode(int_pin, INPUT_PULLUP);
+    attachInterrupt(digitalPinToInterrupt(int_pin), _onExpanderInterrupt, FALLING);
+
+    _mcp_int_flag = true; // forces a first read, which clears INTA
+    _armed        = true;
+
+}
+
+bool     Expander::changed()   const { return !_armed || _mcp_int_flag; }
+uint32_t Expander::changedAt() const { return _mcp_int_us; }
+
+// ----------------------------------------------------------------------------
+// MCP4725 DAC
+// ----------------------------------------------------------------------------
+
+bool Dac::begin(uint8_t const address) { return Adafruit_MCP4725::begin(_address = address); }
+
+bool Dac::setVoltage(uint16_t const output, bool const writeEEPROM) {
+
+    // [addr+W] [command] [data] [data]
+    _count(4);
+    return Adafruit_MCP4725::setVoltage(output, writeEEPROM);
+
+}
+
+bool Dac::fastWrite(uint16_t const output) {
+
+    // [addr+W] [0 0 PD1 PD0 D11 D10 D9 D8] [D7 ... D0]
+    _count(3);
+
+    Wire.beginTransmission(_address);
+    Wire.write((output >> 8) & 0x0f);
+    Wire.write(output & 0xff);
+
+    return Wire.endTransmission() == 0;
+
+}
+
+// ----------------------------------------------------------------------------
+// NeoPixel data line
+// ----------------------------------------------------------------------------
+
+static uint32_t constexpr _LED_BAUD    = 3200000; // 4 symbol bits per frame bit
+static uint8_t  constexpr _LED_CHAR_US = 3;       // time to shift out the last symbol
+
+void LedLine::begin(uint8_t const pin) {
+
+    _pin     = pin; // must be GPIO2 (UART1 TX)
+    _sent_us = micros() - _FRAME_US - _LATCH_US; // the first frame needn't wait
+
+    Serial1.begin(_LED_BAUD, SERIAL_6N1, SERIAL_TX_ONLY);
+    USC0(1) |= 1 << UCTXI; // inverted TX: the line idles low
+
+    close();
+
+}
+
+void LedLine::open() { pinMode(_pin, SPECIAL); }
+
+void LedLine::close() {
+
+    flush();
+
+    pinMode(_pin, OUTPUT);
+    GPIO_REG_WRITE(GPIO_OUT_W1TS_ADDRESS, 1 << _pin);
+
+}
+
+/**
+ * @note The UART encoding is borrowed from NeoPixelBus:
+ * @see  https://github.com/Makuna/NeoPixelBus/blob/master/src/internal/methods/NeoEsp8266UartMethod.h
+ */
+void LedLine::write(uint32_t const color) {
+
+    uint32_t const elapsed = micros() - _sent_us;
+    if (elapsed < _FRAME_US + _LATCH_US) delayMicroseconds(_FRAME_US + _LATCH_US - elapsed);
+
+    // the previous frame has been latched, so the FIFO is empty
+    for (uint8_t i = 0; i < SYMBOLS_PER_FRAME; ++i) USF(1) = symbol(color, i);
+
+    _sent_us = micros();
+
+}
+
+bool LedLine::busy() const { return (USS(1) >> USTXC) & 0xff; }
+
+void LedLine::flush() const {
+
+    if (!busy()) return;
+
+    while (busy());
+    delayMicroseconds(_LED_CHAR_US);
+
+}
+
+// ----------------------------------------------------------------------------
+// Display
+// ----------------------------------------------------------------------------
+
+/**
+ * @note The ST7735 scrolls its memory rows, which only match the rows of
+ *       the screen in the default orientation. The scrolling area is the
+ *       part of the memory actually mapped to the panel.
+ */
+bool scrollDisplay(Display &tft, uint8_t const line) {
+
+    if (tft.getRotation()) return false;
+
+    auto const &cfg = tft.getPanel()->config();
+
+    uint16_t const top    = cfg.offset_y;
+    uint16_t const bottom = cfg.memory_height - cfg.panel_height - cfg.offset_y;
+
+    tft.startWrite();
+    tft.writeCommand(0x33); // VSCRDEF
+    tft.writeData16(top);
+    tft.writeData16(cfg.panel_height);
+    tft.writeData16(bottom);
+    tft.writeCommand(0x37); // VSCRSADD
+    tft.writeData16(top + line % cfg.panel_height);
+    tft.endWrite();
+
+    return true;
+
+}
+
+// ----------------------------------------------------------------------------
+// Background transfer to the display
+// ----------------------------------------------------------------------------
+
+static uint8_t constexpr _SPI_FIFO_WORDS = 16; // W0..W15
+
+static uint32_t const * volatile _blit_src   = nullptr;
+static volatile uint32_t         _blit_words = 0;
+static volatile bool             _blit_busy  = false;
+
+static void IRAM_ATTR _fillFifo() {
+
+    uint32_t const n = _blit_words < _SPI_FIFO_WORDS ? _blit_words : _SPI_FIFO_WORDS;
+    volatile uint32_t * const fifo = &SPI1W0;
+    uint32_t const *src = _blit_src;
+
+    for (uint8_t i = 0; i < n; ++i) fifo[i] = *src++;
+
+    _blit_src    = src;
+    _blit_words -= n;
+
+    SPI1U1   = (SPI1U1 & ~(SPIMMOSI << SPILMOSI)) | (((n << 5) - 1) << SPILMOSI);
+    SPI1CMD |= SPIBUSY;
+
+}
+
+static void IRAM_ATTR _onSpiInterrupt(void *) {
+
+    // the vector is shared with the flash controller
+    if (!(SPIIR & (1 << SPII1))) return;
+
+    SPI1S &= ~0x1f; // acknowledges
+
+    if (_blit_words) {
+        _fillFifo();
+    } else {
+        SPI1S &= ~(1 << SPISTRIE);
+        _blit_busy = false;
+    }
+
+}
+
+AsyncBlit::~AsyncBlit() { finish(); }
+
+void AsyncBlit::begin(Display &tft) {
+
+    _tft = &tft;
+
+    ETS_SPI_INTR_ATTACH(_onSpiInterrupt, nullptr);
+    ETS_SPI_INTR_ENABLE();
+
+}
+
+void AsyncBlit::start(uint16_t const *data, int32_t const x, int32_t const y, int32_t const w, int32_t const h) {
+
+    finish();
+
+    _tft->startWrite();
+    _tft->setAddrWindow(x, y, w, h);
+
+    // the first row goes through LovyanGFX, which leaves the panel
+    // in RAM write mode with the D/C line set for data
+    _tft->writePixels(data, w, false);
+    _tft->waitDMA();
+    while (SPI1CMD & SPIBUSY);
+
+    _writing = true;
+
+    uint32_t const words = (w * (h - 1)) >> 1;
+    if (!words) return;
+
+    _blit_src   = (uint32_t const *)(data + w);
+    _blit_words = words;
+    _blit_busy  = true;
+
+    SPI1S = (SPI1S & ~0x1f) | (1 << SPISTRIE);
+    _fillFifo();
+
+}
+
+bool AsyncBlit::busy() const { return _blit_busy; }
+
+void AsyncBlit::finish() {
+
+    if (!_writing) return;
+
+    while (_blit_busy);
+    while (SPI1CMD & SPIBUSY);
+
+    _tft->endWrite();
+    _writing = false;
+
+}
+
+}
+
+#endif
+
+/*
+ * ----------------------------------------------------------------------------
+ * ESPboy Library
+ * ----------------------------------------------------------------------------
+ * Copyright (c) 2021-2022 Stéphane Calderoni (https://github.com/m1cr0lab)
+ * 
+ * This program is free software: you can redistribute it and/or modify
+ * it under the terms of the GNU General Public License as published by
+ * the Free Software Foundation, either version 3 of the License, or
+ * (at your option) any later version.
+ * 
+ * This program is distributed in the hope that it will be useful,
+ * but WITHOUT ANY WARRANTY; without even the implied warranty of
+ * MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE. See the
+ * GNU General Public License for more details.
+ * 
+ * You should have received a copy of the GNU General Public License
+ * along with this program. If not, see <https://www.gnu.org/licenses/>.
+ * ----------------------------------------------------------------------------
+ */
\ No newline at end of file
@@ -0,0 +1,511 @@
+/**
+ * ----------------------------------------------------------------------------
+ * @file   HAL_Host.cpp
+ * @author Stéphane Calderoni (https://github.com/m1cr0lab)
+ * @brief  Hardware abstraction layer (host stand-in)
+ * ----------------------------------------------------------------------------
+ */
+
+#include "HAL.h"
+
+#if defined(ESPBOY_HAL_HOST)
+
+#include <chrono>
+#include <time.h>
+
+namespace hal {
+
+// ----------------------------------------------------------------------------
+// Time base
+// ----------------------------------------------------------------------------
+
+static bool     _virtual_time = false;
+static uint64_t _virtual_ns   = 0;
+
+static uint64_t _now_ns() {
+
+    if (_virtual_time) return _virtual_ns;
+
+    static timespec origin = {};
+    if (!origin.tv_sec && !origin.tv_nsec) clock_gettime(CLOCK_MONOTONIC, &origin);
+
+    timespec now;
+    clock_gettime(CLOCK_MONOTONIC, &now);
+
+    return (uint64_t)(now.tv_sec - origin.tv_sec) * 1000000000ULL + now.tv_nsec - origin.tv_nsec;
+
+}
+
+uint32_t Clock::ms()     { return _now_ns() / 1000000; }
+uint32_t Clock::us()     { return _now_ns() / 1000;    }
+uint32_t Clock::cycles() { return _now_ns() * (F_CPU / 1000000) / 1000; }
+
+void Clock::useVirtualTime(bool const enabled) {
+
+    if (enabled == _virtual_time) return;
+
+    _virtual_ns   = _now_ns() / 1000 * 1000; // whole microseconds, for reproducible runs
+    _virtual_time = enabled;
+
+}
+
+void Clock::advance(uint32_t const us) { _virtual_ns += (uint64_t)us * 1000; }
+
+// ----------------------------------------------------------------------------
+// Reset cause
+// ----------------------------------------------------------------------------
+
+static bool _deep_sleep_wake = false;
+
+bool Reset::fromDeepSleep() { return _deep_sleep_wake; }
+
+void Reset::simulateDeepSleep(bool const enabled) { _deep_sleep_wake = enabled; }
+
+// ----------------------------------------------------------------------------
+// MCP23017 I/O expander
+// ----------------------------------------------------------------------------
+
+static uint8_t constexpr _MCP_IODIRA   = 0x00;
+static uint8_t constexpr _MCP_GPINTENA = 0x04;
+static uint8_t constexpr _MCP_INTCONA  = 0x08;
+static uint8_t constexpr _MCP_IOCON    = 0x0a;
+static uint8_t constexpr _MCP_GPPUA    = 0x0c;
+static uint8_t constexpr _MCP_GPIOA  = 0x12;
+
+void Expander::_record(uint8_t const reg, uint8_t const length, bool const read, uint16_t const data) {
+
+    // same byte accounting as the ESP8266 implementation
+    _count(read ? 3 + length : 2 + length);
+    transactions.push({ Clock::us(), _address, reg, length, read, data });
+
+}
+
+bool Expander::begin(uint8_t const address) {
+
+    _address = address;
+    _iodir   = 0xffff;
+    _gppu    = 0x0000;
+    _olat    = 0x0000;
+
+    _gpinten     = 0x00;
+    _int_pending = false;
+
+    return true;
+
+}
+
+void Expander::pinMode(uint8_t const pin, uint8_t const mode) {
+
+    uint16_t const bit  = 1 << (pin & 0xf);
+    uint8_t  const port = pin >> 3;
+
+    _record(_MCP_IODIRA + port, 1, true, _iodir >> (port << 3));
+    mode == OUTPUT ? _iodir &= ~bit : _iodir |= bit;
+    _record(_MCP_IODIRA + port, 1, false, _iodir >> (port << 3));
+
+    _record(_MCP_GPPUA + port, 1, true, _gppu >> (port << 3));
+    mode == INPUT_PULLUP ? _gppu |= bit : _gppu &= ~bit;
+    _record(_MCP_GPPUA + port, 1, false, _gppu >> (port << 3));
+
+}
+
+void Expander::digitalWrite(uint8_t const pin, uint8_t const value) {
+
+    uint16_t const bit  = 1 << (pin & 0xf);
+    uint8_t  const port = pin >> 3;
+
+    _record(_MCP_GPIOA + port, 1, true, _olat >> (port << 3));
+    value == LOW ? _olat &= ~bit : _olat |= bit;
+    _record(_MCP_GPIOA + port, 1, false, _olat >> (port << 3));
+
+}
+
+uint8_t Expander::digitalRead(uint8_t const pin) {
+
+    uint8_t const port = pin >> 3;
+    uint8_t const data = readGPIOAB() >> (port << 3);
+
+    return (data >> (pin & 0x7)) & 0x1;
+
+}
+
+uint8_t Expander::readGPIOA() {
+
+    uint8_t const data = (_input & _iodir) | (_olat & ~_iodir);
+    _record(_MCP_GPIOA, 1, true, data);
+    _int_pending = false;
+
+    return data;
+
+}
+
+uint16_t Expander::readGPIOAB() {
+
+    uint16_t const data = (_input & _iodir) | (_olat & ~_iodir);
+    _record(_MCP_GPIOA, 2, true, data);
+    _int_pending = false;
+
+    return data;
+
+}
+
+void Expander::armInterruptOnChange(uint8_t const mask, uint8_t const) {
+
+    _record(_MCP_IOCON, 1, true, 0);
+    _record(_MCP_IOCON, 1, false, 0);
+
+    for (uint8_t i = 0; i < 8; ++i) {
+        if (mask & (1 << i)) {
+            _record(_MCP_INTCONA,  1, true,  0);
+            _record(_MCP_INTCONA,  1, false, 0);
+            _record(_MCP_GPINTENA, 1, true,  _gpinten);
+            _record(_MCP_GPINTENA, 1, false, _gpinten |= 1 << i);
+        }
+    }
+
+    _int_pending = true;
+
+}
+
+bool     Expander::changed()   const { return !_gpinten || _int_pending; }
+uint32_t Expander::changedAt() const { return _int_us; }
+
+void Expander::setButtons(uint8_t const pressed) {
+
+    uint16_t const input = _input;
+
+    // buttons pull their pin down when pressed
+    _input = (_input & 0xff00) | (uint8_t)~pressed;
+
+    if ((input ^ _input) & _gpinten) {
+        _int_pending = true;
+        _int_us      = Clock::us();
+    }
+
+}
+
+// ----------------------------------------------------------------------------
+// MCP4725 DAC
+// ----------------------------------------------------------------------------
+
+bool Dac::begin(uint8_t const address) { _address = address; return true; }
+
+bool Dac::setVoltage(uint16_t const output, bool const writeEEPROM) {
+
+    _count(4);
+    writes.push({ Clock::us(), _value = output & 0xfff, writeEEPROM, false });
+
+    return true;
+
+}
+
+bool Dac::fastWrite(uint16_t const output) {
+
+    _count(3);
+    writes.push({ Clock::us(), _value = output & 0xfff, false, true });
+
+    return true;
+
+}
+
+// ----------------------------------------------------------------------------
+// Drawing surfaces
+// ----------------------------------------------------------------------------
+
+void Canvas::_attach(uint16_t * const buffer, int32_t const width, int32_t const height) {
+
+    _buffer = buffer;
+    _width  = width;
+    _height = height;
+
+    clearClipRect();
+
+}
+
+void Canvas::setClipRect(int32_t const x, int32_t const y, int32_t const w, int32_t const h) {
+
+    _clip_x = x; _clip_y = y;
+    _clip_w = w; _clip_h = h;
+
+}
+
+void Canvas::_write(int32_t const x, int32_t const y, uint16_t const color) {
+
+    if (x < _clip_x || y < _clip_y || x >= _clip_x + _clip_w || y >= _clip_y + _clip_h) return;
+    if (x < 0 || y < 0 || x >= _width || y >= _height) return;
+
+    _written_pixels++;
+
+    if (_bpp == 16) { _buffer[y * _width + x] = color; return; }
+
+    uint32_t const bit   = y * (((_width * _bpp + 7) >> 3) << 3) + x * _bpp;
+    uint8_t  const shift = 8 - _bpp - (bit & 0x7);
+    uint8_t  const mask  = ((1 << _bpp) - 1) << shift;
+    uint8_t * const p    = (uint8_t*)_buffer + (bit >> 3);
+
+    *p = (*p & ~mask) | ((color << shift) & mask);
+
+}
+
+uint16_t Canvas::pixel(int32_t const x, int32_t const y) const {
+
+    if (_bpp == 16) return _buffer[y * _width + x];
+
+    uint32_t const bit = y * (((_width * _bpp + 7) >> 3) << 3) + x * _bpp;
+
+    return (((uint8_t*)_buffer)[bit >> 3] >> (8 - _bpp - (bit & 0x7))) & ((1 << _bpp) - 1);
+
+}
+
+void Canvas::drawRect(int32_t const x, int32_t const y, int32_t const w, int32_t const h, uint16_t const color) {
+
+    drawFastHLine(x, y,         w, color);
+    drawFastHLine(x, y + h - 1, w, color);
+    drawFastVLine(x,         y + 1, h - 2, color);
+    drawFastVLine(x + w - 1, y + 1, h - 2, color);
+
+}
+
+void Canvas::fillRect(int32_t const x, int32_t const y, int32_t const w, int32_t const h, uint16_t const color) {
+
+    for (int32_t j = y; j < y + h; ++j) {
+        for (int32_t i = x; i < x + w; ++i) _write(i, j, color);
+    }
+
+}
+
+void Canvas::drawBitmap(int32_t const x, int32_t const y, uint8_t const *bitmap, int32_t const w, int32_t const h, uint16_t const color) {
+
+    int32_t const stride = (w + 7) >> 3;
+
+    for (int32_t j = 0; j < h; ++j) {
+        for (int32_t i = 0; i < w; ++i) {
+            if (pgm_read_byte(bitmap + j * stride + (i >> 3)) & (0x80 >> (i & 0x7))) _write(x + i, y + j, color);
+        }
+    }
+
+}
+
+void Canvas::pushImage(int32_t const x, int32_t const y, int32_t const w, int32_t const h, uint16_t const *data) {
+
+    for (int32_t j = 0; j < h; ++j) {
+        for (int32_t i = 0; i < w; ++i) _write(x + i, y + j, *data++);
+    }
+
+}
+
+void Canvas::pushImage(int32_t const x, int32_t const y, int32_t const w, int32_t const h, uint16_t const *data, uint16_t const transparent) {
+
+    for (int32_t j = 0; j < h; ++j) {
+        for (int32_t i = 0; i < w; ++i, ++data) if (*data != transparent) _write(x + i, y + j, *data);
+    }
+
+}
+
+void Display::init() {
+
+    memset(_pixels, 0, sizeof(_pixels));
+    _scroll_line = 0;
+    _win_x = _win_y = _win_i = 0;
+    _win_w = WIDTH;
+    _win_h = HEIGHT;
+    clearClipRect();
+    resetStats();
+
+}
+
+void Display::setAddrWindow(int32_t const x, int32_t const y, int32_t const w, int32_t const h) {
+
+    _win_x = x; _win_y = y;
+    _win_w = w; _win_h = h;
+    _win_i = 0;
+
+}
+
+void Display::writePixels(uint16_t const *data, int32_t const length, bool const) {
+
+    for (int32_t n = 0; n < length; ++n, ++_win_i) {
+        if (_win_i == _win_w * _win_h) _win_i = 0;
+        _write(_win_x + _win_i % _win_w, _win_y + _win_i / _win_w, *data++);
+    }
+
+}
+
+bool scrollDisplay(Display &tft, uint8_t const line) {
+
+    tft.setScrollLine(line);
+
+    return true;
+
+}
+
+void *Sprite::createSprite(int32_t const w, int32_t const h) {
+
+    deleteSprite();
+
+    uint16_t * const buffer = (uint16_t*)calloc(((w * _bpp + 7) >> 3) * h, 1);
+    if (buffer) _attach(buffer, w, h);
+
+    return buffer;
+
+}
+
+void Sprite::deleteSprite() {
+
+    free(_buffer);
+    _attach(nullptr, 0, 0);
+
+}
+
+// ----------------------------------------------------------------------------
+// NeoPixel data line
+// ----------------------------------------------------------------------------
+
+void LedLine::begin(uint8_t const pin) {
+
+    _pin     = pin;
+    _sent_us = micros() - _FRAME_US - _LATCH_US; // the first frame needn't wait
+
+    frames.clear();
+    waveform.clear();
+
+}
+
+void LedLine::open()  {}
+void LedLine::close() {}
+
+void LedLine::write(uint32_t const color) {
+
+    uint32_t const elapsed = micros() - _sent_us;
+    if (elapsed < _FRAME_US + _LATCH_US) delayMicroseconds(_FRAME_US + _LATCH_US - elapsed);
+
+    _sent_us = micros();
+
+    frames.push(color & 0xffffff);
+    for (uint8_t i = 0; i < SYMBOLS_PER_FRAME; ++i) waveform.push(symbol(color, i));
+
+}
+
+bool LedLine::busy() const { return false; }
+void LedLine::flush() const {}
+
+// ----------------------------------------------------------------------------
+// Background transfer to the display
+// ----------------------------------------------------------------------------
+
+AsyncBlit::~AsyncBlit() {
+
+    finish();
+
+    if (_worker.joinable()) {
+        { std::lock_guard<std::mutex> lock(_mutex); _quit = true; }
+        _wake.notify_one();
+        _worker.join();
+    }
+
+}
+
+void AsyncBlit::begin(Display &tft) {
+
+    _tft = &tft;
+    if (!_worker.joinable()) _worker = std::thread(&AsyncBlit::_run, this);
+
+}
+
+void AsyncBlit::start(uint16_t const *data, int32_t const x, int32_t const y, int32_t const w, int32_t const h) {
+
+    finish();
+
+    _tft->startWrite();
+    _tft->setAddrWindow(x, y, w, h);
+    _writing = true;
+
+    // in virtual time, the transfer is over at once, so that a run doesn't
+    // depend on how the thread is scheduled
+    if (_virtual_time) { _tft->writePixels(data, w * h); return; }
+
+    {
+        std::lock_guard<std::mutex> lock(_mutex);
+        _data = data;
+        _x = x; _y = y; _w = w; _h = h;
+        _pending = true;
+        _busy    = true;
+    }
+
+    _wake.notify_one();
+
+}
+
+void AsyncBlit::_run() {
+
+    // the FIFO of the ESP8266 SPI controller holds 32 pixels
+    static int32_t constexpr CHUNK = 32;
+
+    std::unique_lock<std::mutex> lock(_mutex);
+
+    for (;;) {
+
+        _wake.wait(lock, [this] { return _pending || _quit; });
+        if (_quit) return;
+
+        _pending = false;
+        uint16_t const *data   = _data;
+        int32_t  const  length = _w * _h;
+        lock.unlock();
+
+        auto const t0 = std::chrono::steady_clock::now();
+
+        for (int32_t n = 0; n < length; n += CHUNK) {
+            _tft->writePixels(data + n, length - n < CHUNK ? length - n : CHUNK);
+            if (!_virtual_time) {
+                std::this_thread::sleep_until(t0 + std::chrono::nanoseconds((uint64_t)(n + CHUNK) * 16 * 1000000000ULL / _SPI_HZ));
+            }
+        }
+
+        lock.lock();
+        _busy = false;
+        _wake.notify_all();
+
+    }
+
+}
+
+bool AsyncBlit::busy() const { return _busy; }
+
+void AsyncBlit::finish() {
+
+    if (!_writing) return;
+
+    std::unique_lock<std::mutex> lock(_mutex);
+    _wake.wait(lock, [this] { return !_busy; });
+    lock.unlock();
+
+    _tft->endWrite();
+    _writing = false;
+
+}
+
+}
+
+#endif
+
+/*
+ * ----------------------------------------------------------------------------
+ * ESPboy Library
+ * ----------------------------------------------------------------------------
+ * Copyright (c) 2021-2022 Stéphane Calderoni (https://github.com/m1cr0lab)
+ * 
+ * This program is free software: you can redistribute it and/or modify
+ * it under the terms of the GNU General Public License as published by
+ * the Free Software Foundation, either version 3 of the License, or
+ * (at your option) any later version.
+ * 
+ * This program is distributed in the hope that it will be useful,
+ * but WITHOUT ANY WARRANTY; without even the implied warranty of
+ * MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE. See the
+ * GNU General Public License for more details.
+ * 
+ * You should have received a copy of the GNU General Public License
+ * along with this program. If not, see <https://www.gnu.org/licenses/>.
+ * ----------------------------------------------------------------------------
+ */
\ No newline at end of file
@@ -0,0 +1,235 @@
+/**
+ * ----------------------------------------------------------------------------
+ * @file   InputLog.cpp
+ * @author Stéphane Calderoni (https://github.com/m1cr0lab)
+ * @brief  Deterministic recording and replay of the push buttons
+ * ----------------------------------------------------------------------------
+ */
+
+#include "InputLog.h"
+
+bool InputLog::record(uint8_t * const buffer, size_t const capacity, uint32_t const seed) {
+
+    stop();
+
+    if (!buffer || capacity < HEADER_SIZE) return false;
+
+    _buffer    = buffer;
+    _log       = buffer;
+    _capacity  = capacity;
+    _size      = HEADER_SIZE;
+    _overflow  = false;
+    _seed      = seed ? seed : (hal::Clock::cycles() ^ micros()) | 1;
+    _period_us = 0;
+    _frames    = _played = _seen = _run = 0;
+    _mode      = _Mode::RECORDING;
+
+    randomSeed(_seed);
+
+    return true;
+
+}
+
+bool InputLog::replay(uint8_t const * const log, size_t const size) {
+
+    stop();
+
+    if (!log || size < HEADER_SIZE) return false;
+
+    if (pgm_read_byte(log) != 'I' || pgm_read_byte(log + 1) != 'L' || pgm_read_byte(log + 2) != _VERSION) return false;
+
+    _log       = log;
+    _size      = size;
+    _seed      = _read32(4);
+    _period_us = _read32(8);
+    _frames    = _read32(12);
+    _pos       = HEADER_SIZE;
+    _played    = _run = 0;
+    _mode      = _Mode::REPLAYING;
+
+    #if defined(ESPBOY_HAL_HOST)
+    hal::Clock::useVirtualTime(true);
+    #endif
+
+    randomSeed(_seed);
+
+    return true;
+
+}
+
+size_t InputLog::stop() {
+
+    if (_mode == _Mode::RECORDING) {
+        if (_run && !_writeRun()) _overflow = true;
+        _writeHeader();
+    }
+
+    _mode = _Mode::IDLE;
+
+    return _size;
+
+}
+
+bool     InputLog::recording()  const { return _mode == _Mode::RECORDING; }
+bool     InputLog::replaying()  const { return _mode == _Mode::REPLAYING; }
+bool     InputLog::overflowed() const { return _overflow;  }
+uint32_t InputLog::seed()       const { return _seed;      }
+uint32_t InputLog::frames()     const { return _frames + (recording() ? _run : 0); }
+uint32_t InputLog::played()     const { return _played;    }
+uint32_t InputLog::period()     const { return _period_us; }
+
+uint8_t const *InputLog::data() const { return _log;  }
+size_t         InputLog::size() const { return _size; }
+
+uint8_t InputLog::frame(uint8_t const buttons) {
+
+    if (_mode == _Mode::RECORDING) {
+
+        uint32_t const now = micros();
+
+        if (!_seen++) _start_us = now;
+        _last_us = now;
+
+        if (_run && buttons == _mask) { _run++; return buttons; }
+
+        if (_run && !_writeRun()) {
+            _overflow = true;
+            stop();
+            return buttons;
+        }
+
+        _mask = buttons;
+        _run  = 1;
+
+        return buttons;
+
+    }
+
+    if (_mode != _Mode::REPLAYING) return buttons;
+
+    if (!_run) {
+
+        if (_played == _frames || _pos >= _size) { _mode = _Mode::IDLE; return buttons; }
+
+        _mask = _read8();
+
+        uint8_t shift = 0, byte;
+        do {
+            byte  = _read8();
+            _run |= (uint32_t)(byte & 0x7f) << shift;
+            shift += 7;
+        } while (byte & 0x80 && shift < 35);
+
+        if (!_run) { _mode = _Mode::IDLE; return buttons; }
+
+    }
+
+    // the replay starts with its first frame, as the recording did
+    if (!_played) _start_us = micros();
+
+    #if defined(ESPBOY_HAL_HOST)
+    // frame i is due i periods after the first one, whatever the game did meanwhile
+    int32_t const ahead = _start_us + _played * _period_us - micros();
+    if (ahead > 0) hal::Clock::advance(ahead);
+    #endif
+
+    _run--;
+    _played++;
+
+    return _mask;
+
+}
+
+bool InputLog::_writeRun() {
+
+    if (_capacity - _size < _MAX_RUN) return false;
+
+    _buffer[_size++] = _mask;
+
+    uint32_t run = _run;
+    while (run > 0x7f) { _buffer[_size++] = (run & 0x7f) | 0x80; run >>= 7; }
+    _buffer[_size++] = run;
+
+    _frames += _run;
+    _run     = 0;
+
+    return true;
+
+}
+
+void InputLog::_writeHeader() {
+
+    _period_us = _seen > 1 ? (_last_us - _start_us) / (_seen - 1) : 0;
+
+    _buffer[0] = 'I';
+    _buffer[1] = 'L';
+    _buffer[2] = _VERSION;
+    _buffer[3] = 0;
+
+    _write32(4,  _seed);
+    _write32(8,  _period_us);
+    _write32(12, _frames);
+
+}
+
+void InputLog::_write32(size_t const pos, uint32_t const value) {
+
+    for (uint8_t i = 0; i < 4; ++i) _buffer[pos + i] = value >> (i << 3);
+
+}
+
+uint8_t InputLog::_read8() { return _pos < _size ? pgm_read_byte(_log + _pos++) : 0; }
+
+uint32_t InputLog::_read32(size_t const pos) const {
+
+    uint32_t value = 0;
+    for (uint8_t i = 0; i < 4; ++i) value |= (uint32_t)pgm_read_byte(_log + pos + i) << (i << 3);
+
+    return value;
+
+}
+
+void InputLog::dump(Print &out, char const * const name) const {
+
+    if (_size < HEADER_SIZE) return;
+
+    char buffer[64];
+
+    snprintf(buffer, sizeof(buffer), "static uint8_t const %s[] PROGMEM = {", name);
+    out.println(buffer);
+
+    snprintf(buffer, sizeof(buffer), "    // %lu frames, %lu us per frame", (unsigned long)_read32(12), (unsigned long)_read32(8));
+    out.println(buffer);
+
+    for (size_t i = 0; i < _size; ++i) {
+
+        snprintf(buffer, sizeof(buffer), "%s0x%02x%s", i & 15 ? " " : "    ", pgm_read_byte(_log + i), i + 1 < _size ? "," : "");
+        out.print(buffer);
+        if ((i & 15) == 15 || i + 1 == _size) out.println();
+
+    }
+
+    out.println("};");
+
+}
+
+/*
+ * ----------------------------------------------------------------------------
+ * ESPboy Library
+ * ----------------------------------------------------------------------------
+ * Copyright (c) 2021-2022 Stéphane Calderoni (https://github.com/m1cr0lab)
+ * 
+ * This program is free software: you can redistribute it and/or modify
+ * it under the terms of the GNU General Public License as published by
+ * the Free Software Foundation, either version 3 of the License, or
+ * (at your option) any later version.
+ * 
+ * This program is distributed in the hope that it will be useful,
+ * but WITHOUT ANY WARRANTY; without even the implied warranty of
+ * MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE. See the
+ * GNU General Public License for more details.
+ * 
+ * You should have received a copy of the GNU General Public License
+ * along with this program. If not, see <https://www.gnu.org/licenses/>.
+ * ----------------------------------------------------------------------------
+ */
\ No newline at end of file
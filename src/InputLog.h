@@ -0,0 +1,206 @@
+/**
+ * ----------------------------------------------------------------------------
+ * @file   InputLog.h
+ * @author Stéphane Calderoni (https://github.com/m1cr0lab)
+ * @brief  Deterministic recording and replay of the push buttons
+ * ----------------------------------------------------------------------------
+ */
+
+#pragma once
+
+#include <Arduino.h>
+#include "HAL.h"
+
+/**
+ * @brief This class records the state of the push buttons at each frame,
+ *        along with the seed of the random number generator, and replays
+ *        them later on, so that a game session can be played again frame
+ *        for frame.
+ * 
+ * @details Sessions are recorded into a buffer provided by the caller:
+ * 
+ *            uint8_t session[2048];
+ * 
+ *            void setup() {
+ *                espboy.input.record(session, sizeof(session));
+ *                espboy.begin();
+ *                ...
+ *            }
+ * 
+ *          and, once stop() has been called, dump() writes the log as a C
+ *          array, which can be stored in flash memory and given to replay(),
+ *          or replayed headlessly on a Linux box (see extras/host/replay.cpp).
+ * 
+ *          ESPboy::update() hands the buttons it has just read over to
+ *          frame(), and feeds the debouncer with the mask it returns: the
+ *          same mask while recording, the recorded one while replaying.
+ *          Both record() and replay() call randomSeed() with the seed of
+ *          the log, and a game drawing its numbers from a Random generator
+ *          should seed it with seed() as well.
+ * 
+ *          The log starts with a 16-byte header:
+ * 
+ *            'I', 'L', version, 0
+ *            seed                  (32 bits, little-endian)
+ *            frame period in µs    (32 bits, average over the recording)
+ *            number of frames      (32 bits)
+ * 
+ *          followed by runs of identical frames: the button mask, then the
+ *          length of the run as a variable-length integer (7 bits per byte,
+ *          least significant group first, bit 7 set when another byte
+ *          follows). Since the buttons only change a few times per second,
+ *          a minute of play typically takes a few hundred bytes.
+ * 
+ *          On the host, replay() switches the clock to virtual time, which
+ *          then moves forward by one recorded frame period per frame: the
+ *          session runs unthrottled, and millis() and micros() read exactly
+ *          the same values from one replay to the next. On the ESP8266, the
+ *          session is replayed in real time.
+ */
+class InputLog {
+
+    public:
+
+        static uint8_t constexpr HEADER_SIZE = 16;
+
+    private:
+
+        static uint8_t constexpr _VERSION = 1;
+        static uint8_t constexpr _MAX_RUN = 6; // mask + 5-byte length
+
+        enum class _Mode : uint8_t { IDLE, RECORDING, REPLAYING };
+
+        _Mode          _mode = _Mode::IDLE;
+        uint8_t       *_buffer;        // recording buffer
+        uint8_t const *_log = nullptr; // log being replayed (RAM or flash memory)
+        size_t         _capacity;
+        size_t         _size = 0;
+        size_t         _pos;
+        bool           _overflow;
+
+        uint32_t _seed;
+        uint32_t _period_us;
+        uint32_t _frames;    // frames covered by the runs written so far, or to replay
+        uint32_t _played;
+        uint32_t _seen;      // frames seen by the recorder
+        uint8_t  _mask;
+        uint32_t _run;       // frames left in the current run
+        uint32_t _start_us;
+        uint32_t _last_us;
+
+        bool     _writeRun();
+        void     _writeHeader();
+        void     _write32(size_t const pos, uint32_t const value);
+        uint8_t  _read8();
+        uint32_t _read32(size_t const pos) const;
+
+    public:
+
+        /**
+         * @brief Starts recording.
+         * 
+         * @param buffer   Where to write the log.
+         * @param capacity Size of the buffer, in bytes.
+         * @param seed     Seed of the random number generator, drawn from
+         *                 the clock when null.
+         * 
+         * @return false if the buffer can't even hold the header.
+         * 
+         * @details Call it before the game draws its first random number.
+         *          When the buffer is full, the recording stops by itself,
+         *          and overflowed() returns true.
+         */
+        bool record(uint8_t * const buffer, size_t const capacity, uint32_t const seed = 0);
+
+        /**
+         * @brief Starts replaying a log.
+         * 
+         * @param log  Log written by dump(), in RAM or flash memory.
+         * @param size Size of the log, in bytes.
+         * 
+         * @return false if this is not a log.
+         * 
+         * @details Once the last frame has been played, replaying() returns
+         *          false and the actual buttons are read again.
+         */
+        bool replay(uint8_t const * const log, size_t const size);
+
+        /**
+         * @brief Stops recording (and completes the log) or replaying.
+         * 
+         * @return Size of the log, in bytes.
+         */
+        size_t stop();
+
+        bool recording() const;
+        bool replaying() const;
+
+        /**
+         * @brief Whether the recording stopped because the buffer was full.
+         */
+        bool overflowed() const;
+
+        /**
+         * @brief Seed of the random number generator for the session.
+         */
+        uint32_t seed() const;
+
+        /**
+         * @brief Number of frames recorded so far, or to replay.
+         */
+        uint32_t frames() const;
+
+        /**
+         * @brief Number of frames replayed so far.
+         */
+        uint32_t played() const;
+
+        /**
+         * @brief Average frame period of the recording, in microseconds.
+         */
+        uint32_t period() const;
+
+        /**
+         * @brief Completed log (once stop() has been called).
+         */
+        uint8_t const *data() const;
+        size_t size() const;
+
+        /**
+         * @brief Records or replays a frame.
+         * 
+         * @param buttons Actual state of the buttons (PAD_* bitmask).
+         * 
+         * @return The state of the buttons to be used for this frame.
+         * 
+         * @details Called by ESPboy::update().
+         */
+        uint8_t frame(uint8_t const buttons);
+
+        /**
+         * @brief Writes the completed log as a C array stored in flash memory.
+         */
+        void dump(Print &out, char const * const name = "SESSION") const;
+
+};
+
+/*
+ * ----------------------------------------------------------------------------
+ * ESPboy Library
+ * ----------------------------------------------------------------------------
+ * Copyright (c) 2021-2022 Stéphane Calderoni (https://github.com/m1cr0lab)
+ * 
+ * This program is free software: you can redistribute it and/or modify
+ * it under the terms of the GNU General Public License as published by
+ * the Free Software Foundation, either version 3 of the License, or
+ * (at your option) any later version.
+ * 
+ * This program is distributed in the hope that it will be useful,
+ * but WITHOUT ANY WARRANTY; without even the implied warranty of
+ * MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE. See the
+ * GNU General Public License for more details.
+ * 
+ * You should have received a copy of the GNU General Public License
+ * along with this program. If not, see <https://www.gnu.org/licenses/>.
+ * ----------------------------------------------------------------------------
+ */
\ No newline at end of file
@@ -0,0 +1,209 @@
+/**
+ * ----------------------------------------------------------------------------
+ * @file   Life.cpp
+ * @author Stéphane Calderoni (https://github.com/m1cr0lab)
+ * @brief  Bit-packed engine for Conway's Game of Life
+ * ----------------------------------------------------------------------------
+ */
+
+#include "Life.h"
+
+#include <new>
+
+Life::Life(uint16_t const width, uint16_t const height)
+: _width(width)
+, _height(height)
+, _words(width >> 5)
+, _grid { nullptr, nullptr }
+, _sums(nullptr)
+, _current(0)
+, _generation(0)
+{}
+
+Life::~Life() { end(); }
+
+bool Life::begin() {
+
+    if (!_words || _width & 0x1f) return false;
+
+    end();
+
+    uint32_t const size = _words * _height;
+
+    _grid[0] = new (std::nothrow) uint32_t[size];
+    _grid[1] = new (std::nothrow) uint32_t[size];
+    _sums    = new (std::nothrow) uint32_t[6 * _words];
+
+    if (!_grid[0] || !_grid[1] || !_sums) { end(); return false; }
+
+    clear();
+
+    return true;
+
+}
+
+void Life::end() {
+
+    delete[] _grid[0];
+    delete[] _grid[1];
+    delete[] _sums;
+
+    _grid[0] = _grid[1] = _sums = nullptr;
+
+}
+
+uint16_t Life::width()  const { return _width;  }
+uint16_t Life::height() const { return _height; }
+
+void Life::clear() {
+
+    memset(_grid[_current], 0, _words * _height * sizeof(uint32_t));
+    _generation = 0;
+
+}
+
+void Life::randomize(uint8_t const density) {
+
+    clear();
+
+    for (uint16_t y = 0; y < _height; ++y) {
+        for (uint16_t x = 0; x < _width; ++x) {
+            if (!random(density)) set(x, y);
+        }
+    }
+
+}
+
+bool Life::get(uint16_t const x, uint16_t const y) const {
+
+    return _grid[_current][y * _words + (x >> 5)] >> (31 - (x & 0x1f)) & 0x1;
+
+}
+
+void Life::set(uint16_t const x, uint16_t const y, bool const alive) {
+
+    uint32_t * const w    = &_grid[_current][y * _words + (x >> 5)];
+    uint32_t   const mask = 0x80000000 >> (x & 0x1f);
+
+    alive ? *w |= mask : *w &= ~mask;
+
+}
+
+/**
+ * @brief Counts the live cells of each 1x3 horizontal block of a row,
+ *        as 2-bit numbers spread over two bit planes.
+ */
+void Life::_rowSum(uint32_t const *row, uint32_t *lo, uint32_t *hi) const {
+
+    uint8_t const n = _words;
+
+    for (uint8_t k = 0; k < n; ++k) {
+
+        uint32_t const c = row[k];
+        uint32_t const l = c >> 1 | (k         ? row[k - 1] << 31 : 0); // left neighbours
+        uint32_t const r = c << 1 | (k + 1 < n ? row[k + 1] >> 31 : 0); // right neighbours
+        uint32_t const x = l ^ c;
+
+        lo[k] = x ^ r;
+        hi[k] = (l & c) | (r & x);
+
+    }
+
+}
+
+void Life::step() {
+
+    uint8_t  const  n   = _words;
+    uint32_t const *src = _grid[_current];
+    uint32_t       *dst = _grid[_current ^ 1];
+
+    // sums of the rows above, at and below the current one
+    uint32_t *lo0 = _sums,         *hi0 = _sums +     n;
+    uint32_t *lo1 = _sums + 2 * n, *hi1 = _sums + 3 * n;
+    uint32_t *lo2 = _sums + 4 * n, *hi2 = _sums + 5 * n;
+
+    memset(lo0, 0, 2 * n * sizeof(uint32_t)); // the row above the grid is dead
+    _rowSum(src, lo1, hi1);
+
+    for (uint16_t y = 0; y < _height; ++y, src += n, dst += n) {
+
+        if (y + 1 < _height) {
+            _rowSum(src + n, lo2, hi2);
+        } else {
+            memset(lo2, 0, n * sizeof(uint32_t)); // the row below the grid is dead
+            memset(hi2, 0, n * sizeof(uint32_t));
+        }
+
+        for (uint8_t k = 0; k < n; ++k) {
+
+            // 3x3 block count (0..9) modulo 8, as three bit planes
+            uint32_t const x0 = lo0[k] ^ lo1[k];
+            uint32_t const s0 = x0 ^ lo2[k];
+            uint32_t const c0 = (lo0[k] & lo1[k]) | (lo2[k] & x0);
+            uint32_t const x1 = hi0[k] ^ hi1[k];
+            uint32_t const p  = x1 ^ hi2[k];
+            uint32_t const q  = (hi0[k] & hi1[k]) | (hi2[k] & x1);
+            uint32_t const s1 = p ^ c0;
+            uint32_t const s2 = q ^ (p & c0);
+
+            // count == 3, or count == 4 and alive
+            dst[k] = (s0 & s1 & ~s2) | (src[k] & ~s0 & ~s1 & s2);
+
+        }
+
+        uint32_t * const lo = lo0; lo0 = lo1; lo1 = lo2; lo2 = lo;
+        uint32_t * const hi = hi0; hi0 = hi1; hi1 = hi2; hi2 = hi;
+
+    }
+
+    _current ^= 1;
+    _generation++;
+
+}
+
+uint32_t Life::generation() const { return _generation; }
+
+uint32_t Life::population() const {
+
+    uint32_t const *w   = _grid[_current];
+    uint32_t const  end = _words * _height;
+    uint32_t        pop = 0;
+
+    for (uint32_t i = 0; i < end; ++i) pop += __builtin_popcount(w[i]);
+
+    return pop;
+
+}
+
+uint32_t const *Life::cells() const { return _grid[_current]; }
+
+void Life::blit(hal::Sprite &sprite) const {
+
+    uint32_t const *src = _grid[_current];
+    uint32_t       *dst = (uint32_t *)sprite.getBuffer();
+    uint32_t const  end = _words * _height;
+
+    for (uint32_t i = 0; i < end; ++i) dst[i] = __builtin_bswap32(src[i]);
+
+}
+
+/*
+ * ----------------------------------------------------------------------------
+ * ESPboy Library
+ * ----------------------------------------------------------------------------
+ * Copyright (c) 2021-2022 Stéphane Calderoni (https://github.com/m1cr0lab)
+ * 
+ * This program is free software: you can redistribute it and/or modify
+ * it under the terms of the GNU General Public License as published by
+ * the Free Software Foundation, either version 3 of the License, or
+ * (at your option) any later version.
+ * 
+ * This program is distributed in the hope that it will be useful,
+ * but WITHOUT ANY WARRANTY; without even the implied warranty of
+ * MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE. See the
+ * GNU General Public License for more details.
+ * 
+ * You should have received a copy of the GNU General Public License
+ * along with this program. If not, see <https://www.gnu.org/licenses/>.
+ * ----------------------------------------------------------------------------
+ */
\ No newline at end of file
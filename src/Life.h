@@ -0,0 +1,131 @@
+/**
+ * ----------------------------------------------------------------------------
+ * @file   Life.h
+ * @author Stéphane Calderoni (https://github.com/m1cr0lab)
+ * @brief  Bit-packed engine for Conway's Game of Life
+ * ----------------------------------------------------------------------------
+ */
+
+#pragma once
+
+#include "HAL.h"
+
+/**
+ * @brief This class computes the generations of Conway's Game of Life on a
+ *        grid whose cells are packed 32 per word.
+ * 
+ * @details The leftmost cell of a word is held by its most significant bit.
+ *          A generation is computed 32 cells at a time with bitwise adders:
+ *          the horizontal sums of each row (2 bits per cell) are computed
+ *          once and added up vertically with the rows above and below, which
+ *          gives, for each cell, the number of live cells in its 3x3 block.
+ *          A cell is then alive in the next generation if this number is 3,
+ *          or 4 and the cell is already alive.
+ * 
+ *          The grid is surrounded by dead cells. Two grids are allocated,
+ *          and the engine switches from one to the other at each generation
+ *          without any copy: a 128x128 universe takes 4 KB instead of the
+ *          32 KB of a grid with one byte per cell.
+ */
+class Life {
+
+    private:
+
+        uint16_t  _width;
+        uint16_t  _height;
+        uint8_t   _words;    // per row
+        uint32_t *_grid[2];
+        uint32_t *_sums;     // horizontal sums of 3 consecutive rows
+        uint8_t   _current;
+        uint32_t  _generation;
+
+        void _rowSum(uint32_t const *row, uint32_t *lo, uint32_t *hi) const;
+
+    public:
+
+        /**
+         * @param width  Width of the universe (a multiple of 32).
+         * @param height Height of the universe.
+         */
+        Life(uint16_t const width = 128, uint16_t const height = 128);
+        ~Life();
+
+        /**
+         * @brief Allocates the universe, with all its cells dead.
+         * 
+         * @return true if the allocation has succeeded.
+         */
+        bool begin();
+
+        /**
+         * @brief Releases the universe.
+         */
+        void end();
+
+        uint16_t width()  const;
+        uint16_t height() const;
+
+        /**
+         * @brief Kills all the cells.
+         */
+        void clear();
+
+        /**
+         * @brief Brings each cell to life with a probability of 1 / density.
+         */
+        void randomize(uint8_t const density = 5);
+
+        bool get(uint16_t const x, uint16_t const y) const;
+        void set(uint16_t const x, uint16_t const y, bool const alive = true);
+
+        /**
+         * @brief Computes the next generation.
+         */
+        void step();
+
+        /**
+         * @brief Number of generations computed since the last clear() or randomize().
+         */
+        uint32_t generation() const;
+
+        /**
+         * @brief Number of live cells.
+         */
+        uint32_t population() const;
+
+        /**
+         * @brief Current grid: height rows of width / 32 words.
+         */
+        uint32_t const *cells() const;
+
+        /**
+         * @brief Copies the grid into the buffer of a 1-bit sprite of the same size.
+         * 
+         * @details The rows are copied word by word, each one being stored
+         *          in big-endian order so that its leftmost cell lands in the
+         *          most significant bit of the first byte, as in the sprite.
+         */
+        void blit(hal::Sprite &sprite) const;
+
+};
+
+/*
+ * ----------------------------------------------------------------------------
+ * ESPboy Library
+ * ----------------------------------------------------------------------------
+ * Copyright (c) 2021-2022 Stéphane Calderoni (https://github.com/m1cr0lab)
+ * 
+ * This program is free software: you can redistribute it and/or modify
+ * it under the terms of the GNU General Public License as published by
+ * the Free Software Foundation, either version 3 of the License, or
+ * (at your option) any later version.
+ * 
+ * This program is distributed in the hope that it will be useful,
+ * but WITHOUT ANY WARRANTY; without even the implied warranty of
+ * MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE. See the
+ * GNU General Public License for more details.
+ * 
+ * You should have received a copy of the GNU General Public License
+ * along with this program. If not, see <https://www.gnu.org/licenses/>.
+ * ----------------------------------------------------------------------------
+ */
\ No newline at end of file
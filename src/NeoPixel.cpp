@@ -8,14 +8,19 @@
 
 #include "NeoPixel.h"
 
-void NeoPixel::begin(Adafruit_MCP23X17 &mcp) {
+void NeoPixel::begin(hal::Expander &mcp) {
 
-    pinMode(_LED_PIN, OUTPUT);
+    _line.begin(_LED_PIN);
 
     _mcp = &mcp;
     _mcp->pinMode(_MCP23017_LED_LOCK_PIN, OUTPUT);
 
-    _fx = _FX::NONE;
+    _grb      = _UNKNOWN;
+    _unlocked = false;
+
+    _queue_head  = 0;
+    _queue_count = 0;
+    _stop();
     
     setBrightness(0x20);
     clear();
@@ -24,40 +29,55 @@ void NeoPixel::begin(Adafruit_MCP23X17 &mcp) {
 
 void NeoPixel::update() {
 
-    switch (_fx) {
+    if (!playing()) return;
 
-        case _FX::FLASH:   _flash();   break;
-        case _FX::BREATHE: _breathe(); break;
-        case _FX::RAINBOW: _rainbow(); break;
-        default:;
+    uint32_t const now = millis();
 
-    }
+    if ((int32_t)(now - _next_ms) >= 0) _animate(now);
     
 }
 
 void NeoPixel::setBrightness(uint8_t const b) { _brightness = b + 1; }
 
 void NeoPixel::clear() const { show(0); }
-void NeoPixel::reset() { _fx = _FX::NONE; clear(); }
+void NeoPixel::reset() { _stop(); _queue_count = 0; clear(); }
 
 void NeoPixel::show(uint32_t color) const {
 
-    _show(_rgb2grb(color));
+    _show(Color::rgb2grb(_color = color));
+
+}
+
+void NeoPixel::play(LedTrack const &track, uint32_t const tint) {
+
+    _queue_count = 0;
+    _start({ track, tint });
+
+}
+
+bool NeoPixel::queue(LedTrack const &track, uint32_t const tint) {
+
+    if (!playing()) { _start({ track, tint }); return true; }
+
+    if (_queue_count == _QUEUE_SIZE) return false;
+
+    _queue[(_queue_head + _queue_count++) % _QUEUE_SIZE] = { track, tint };
+
+    return true;
 
 }
 
+bool NeoPixel::playing() const { return _current.track.count; }
+
 void NeoPixel::flash(uint32_t const color, uint16_t const duration_ms, uint8_t const count, uint16_t const period_ms) {
 
-    _fx             = _FX::FLASH;
-    _fx_color       = color;
-    _fx_start_ms    = millis();
-    _fx_duration_ms = duration_ms;
-    _fx_period_ms   = period_ms;
-    _fx_count       = count;
-    _fx_looping     = count == 0;
-    _flashing       = true;
+    uint16_t const pause = period_ms > duration_ms ? period_ms - duration_ms : 0;
 
-    show(color);
+    _fx_keys[0] = { color, 0,           Easing::STEP };
+    _fx_keys[1] = { 0,     duration_ms, Easing::STEP };
+    _fx_keys[2] = { 0,     pause,       Easing::STEP };
+
+    play(LedTrack(_fx_keys, 3, count, false));
     
 }
 
@@ -65,13 +85,14 @@ void NeoPixel::breathe(uint32_t const color, uint16_t const period_ms, uint8_t c
 
     if (!period_ms) return;
 
-    _fx             = _FX::BREATHE;
-    _fx_period_ms   = period_ms;
-    _fx_offset      = 0;
-    _fx_color       = color;
-    _fx_start_ms    = millis();
-    _fx_count       = count;
-    _fx_looping     = count == 0;
+    uint16_t const rise = period_ms >> 1;
+    uint16_t const fall = period_ms - rise;
+
+    _fx_keys[0] = { 0,     0,    Easing::STEP        };
+    _fx_keys[1] = { color, rise, Easing::EASE_IN_OUT };
+    _fx_keys[2] = { 0,     fall, Easing::EASE_IN_OUT };
+
+    play(LedTrack(_fx_keys, 3, count, false));
 
 }
 
@@ -79,146 +100,166 @@ void NeoPixel::rainbow(uint16_t const period_ms, uint8_t const count) {
 
     if (!period_ms) return;
 
-    _fx             = _FX::RAINBOW;
-    _fx_period_ms   = period_ms;
-    _fx_offset      = 0;
-    _fx_start_ms    = millis();
-    _fx_count       = count;
-    _fx_looping     = count == 0;
+    // linear RGB blends between the vertices of the hue wheel
+    static uint32_t constexpr VERTEX[] = { 0xff0000, 0xffff00, 0x00ff00, 0x00ffff, 0x0000ff, 0xff00ff, 0xff0000 };
 
-    show(Color::hsv2rgb(_fx_offset));
+    _fx_keys[0] = { VERTEX[0], 0, Easing::STEP };
 
-}
+    for (uint8_t i = 1; i < 7; ++i) {
+        uint16_t const duration = (uint32_t)period_ms * i / 6 - (uint32_t)period_ms * (i - 1) / 6;
+        _fx_keys[i] = { VERTEX[i], duration, Easing::LINEAR };
+    }
 
-uint32_t NeoPixel::_rgb2grb(uint32_t const rgb) const {
+    // passed through at once between two cycles, and turns the LED off after the last one
+    _fx_keys[7] = { 0, 0, Easing::STEP };
 
-    return (((rgb >> 8) & 0xff) << 16) |
-            ((rgb >> 16)        <<  8) |
-             (rgb & 0xff);
+    play(LedTrack(_fx_keys, _FX_KEYS, count, false));
 
 }
 
-uint8_t NeoPixel::_sine(uint8_t const i) const {
+void NeoPixel::_start(_Entry const &entry) {
 
-    switch (i >> 6) {
+    _current      = entry;
+    _loops_left   = entry.track.loops;
+    _key_index    = 0;
+    _from         = _color;
+    _key_start_ms = millis();
 
-        case 0:  return  pgm_read_byte(_FAST_SINE + i);           // [  0 -  63]
-        case 1:  return ~pgm_read_byte(_FAST_SINE + (~i & 0x3f)); // [ 64 - 127]
-        case 2:  return ~pgm_read_byte(_FAST_SINE + ( i & 0x3f)); // [128 - 191]
-        default: return  pgm_read_byte(_FAST_SINE + (~i & 0x3f)); // [192 - 255]
+    if (!playing()) return;
 
-    }
+    _loadKey();
+    _animate(_key_start_ms);
 
 }
 
-void NeoPixel::_flash() {
+void NeoPixel::_stop() { _current.track = LedTrack(); }
 
-    if (!_fx_looping && !_fx_count) { _fx = _FX::NONE; return; }
+void NeoPixel::_loadKey() {
 
-    if (millis() - _fx_start_ms < _fx_duration_ms) return;
+    LedKey const * const key = _current.track.keys + _key_index;
 
-    if (_flashing) { clear(); _flashing = false; _fx_count--; return; }
+    if (_current.track.progmem) memcpy_P(&_key, key, sizeof(LedKey));
+    else                        _key = *key;
 
-    if (millis() - _fx_start_ms < _fx_period_ms) return;
+    _key.color = _tint(_key.color);
 
-    _fx_start_ms += _fx_period_ms;
-    _flashing = true;
+}
 
-    show(_fx_color);
+bool NeoPixel::_nextKey() {
 
-}
+    if (++_key_index == _current.track.count) {
 
-void NeoPixel::_breathe() {
+        _key_index = 0;
 
-    if (!_fx_looping && !_fx_count) { reset(); return; }
+        if (_loops_left != 1) {
 
-    static uint8_t n = 0;
+            if (_loops_left) _loops_left--; // 0 loops indefinitely
 
-    uint16_t r = (millis() - _fx_start_ms) % _fx_period_ms;
-    uint8_t  l = 256 * r / _fx_period_ms;
+        } else if (_queue_count) {
 
-    switch (n) {
-        case 0: if (l > _fx_offset) n = 1; break;
-        case 1: if (l < _fx_offset) n = 2; break;
-        default: n = 0; _fx_count--; if (!_fx_count) return;
-    }
+            _current    = _queue[_queue_head];
+            _loops_left = _current.track.loops;
+            _queue_head = (_queue_head + 1) % _QUEUE_SIZE;
+            _queue_count--;
 
-    uint32_t const color = _fx_color;
-    uint8_t  const lumin = _sine(_fx_offset = l) + 1;
+        } else return false;
 
-    if (lumin) {
-        uint8_t c, *p = (uint8_t*)&color;
-        for (uint8_t i=0; i<3; ++i) {
-            c = *p;
-            *p++ = (c * lumin) >> 8;
-        }
     }
 
-    show(color);
+    _loadKey();
+
+    return true;
 
 }
 
-void NeoPixel::_rainbow() {
+void NeoPixel::_animate(uint32_t const now) {
 
-    if (!_fx_looping && !_fx_count) { reset(); return; }
+    uint32_t elapsed = now - _key_start_ms;
+    uint8_t  guard   = _current.track.count + 1; // a whole track of zero-length keys
 
-    uint16_t r = (millis() - _fx_start_ms) % _fx_period_ms;
-    uint16_t h = 360 * r / _fx_period_ms;
+    while (elapsed >= _key.duration_ms) {
 
-    if (h < _fx_offset) _fx_count--;
+        _from          = _key.color;
+        _key_start_ms += _key.duration_ms;
+        elapsed       -= _key.duration_ms;
 
-    show(Color::hsv2rgb(_fx_offset = h));
+        if (!_nextKey()) { _stop(); show(_from); return; }
+        if (!--guard)    { show(_from); _next_ms = now + 1; return; }
 
-}
+    }
 
-/**
- * @note Inspired by these references:
- * @see  https://github.com/adafruit/Adafruit_NeoPixel/blob/master/esp8266.c
- * @see  https://github.com/ESPboy-edu/ESPboy_Classes/blob/main/ESPboy_LED/ESPboyLED.cpp
- */
-void IRAM_ATTR NeoPixel::_show(uint32_t const color) const {
+    uint32_t const end = _key_start_ms + _key.duration_ms;
+
+    if (_key.easing == Easing::STEP || _from == _key.color) {
+        show(_from);
+        _next_ms = end;
+        return;
+    }
+
+    uint8_t const e = Ease::apply(_key.easing, (elapsed << 8) / _key.duration_ms);
 
-    static const uint32_t pin_mask = 1 << _LED_PIN;
-    uint32_t t, c, start, mask;
+    uint32_t color = 0;
+    uint8_t  delta = 0;
 
-    if (_brightness) {
+    for (uint8_t shift = 0; shift < 24; shift += 8) {
 
-        uint8_t *p = (uint8_t*)&color;
-        for (uint8_t i=0; i<3; ++i) {
-            c = *p;
-            *p++ = (c * _brightness) >> 8;
-        }
+        int16_t const a = _from      >> shift & 0xff;
+        int16_t const b = _key.color >> shift & 0xff;
+        int16_t const d = b - a;
+
+        color |= (uint32_t)(a + (d * e >> 8)) << shift;
+        if (abs(d) > delta) delta = abs(d);
 
     }
-    
-    mask  = 0x800000;
-    start = 0;
 
-    GPIO_REG_WRITE(GPIO_OUT_W1TC_ADDRESS, pin_mask);  // light on the onboard LED
-    _mcp->digitalWrite(_MCP23017_LED_LOCK_PIN, HIGH); // and open the transistor lock
+    show(color);
+
+    // the LED only changes once one of its components moves by one step,
+    // the slope of the eased curves being up to twice the linear one
+    uint16_t const steps = (delta * (_brightness ? _brightness : 0x100)) >> 8;
+    uint16_t const dt    = steps ? _key.duration_ms / (steps << (_key.easing != Easing::LINEAR)) : _key.duration_ms;
 
-    os_intr_lock();
+    _next_ms = now + (dt ? dt : 1);
+    if ((int32_t)(_next_ms - end) > 0) _next_ms = end;
 
-    for (uint8_t i = 0; i < 24; ++i) {
+}
 
-        t = color & mask ? CYCLES_800_T1H : CYCLES_800_T0H;
+uint32_t NeoPixel::_tint(uint32_t const color) const {
 
-        while ((c = ESP.getCycleCount()) - start < CYCLES_800); // wait for bit start
-        GPIO_REG_WRITE(GPIO_OUT_W1TS_ADDRESS, pin_mask);        // then set LED pin to HIGH
+    uint32_t const tint = _current.tint;
 
-        start = c;
-        
-        while (ESP.getCycleCount() - start < t);         // wait for HIGH duration
-        GPIO_REG_WRITE(GPIO_OUT_W1TC_ADDRESS, pin_mask); // then set LED pin to LOW
+    if (tint == _WHITE) return color;
 
-        mask >>= 1;
+    return ((color >> 16 & 0xff) * ((tint >> 16 & 0xff) + 1) >> 8) << 16 |
+           ((color >>  8 & 0xff) * ((tint >>  8 & 0xff) + 1) >> 8) <<  8 |
+           ((color       & 0xff) * ((tint       & 0xff) + 1) >> 8);
 
+}
+
+void NeoPixel::_show(uint32_t const color) const {
+
+    uint32_t const grb = _brightness
+        ? ((color >> 16 & 0xff) * _brightness >> 8) << 16 |
+          ((color >>  8 & 0xff) * _brightness >> 8) <<  8 |
+          ((color       & 0xff) * _brightness >> 8)
+        : color;
+
+    if (grb == _grb) return;
+
+    if (!_unlocked) {
+        _line.open();                                     // light on the onboard LED
+        _mcp->digitalWrite(_MCP23017_LED_LOCK_PIN, HIGH); // and open the transistor lock
+        _unlocked = true;
     }
 
-    os_intr_unlock();
+    _line.write(_grb = grb);
 
-    _mcp->digitalWrite(_MCP23017_LED_LOCK_PIN, LOW); // close the transistor lock
-    GPIO_REG_WRITE(GPIO_OUT_W1TS_ADDRESS, pin_mask); // light off the onboard LED
+    if (!grb) {
+        _line.flush();
+        _mcp->digitalWrite(_MCP23017_LED_LOCK_PIN, LOW); // close the transistor lock
+        _line.close();                                   // light off the onboard LED
+        _unlocked = false;
+    }
 
 }
 
@@ -9,67 +9,114 @@
 #pragma once
 
 #include <Arduino.h>
-#include <Adafruit_MCP23X17.h>
+#include "HAL.h"
 #include "Color.h"
+#include "Easing.h"
+
+/**
+ * @brief A keyframe of an LED animation.
+ */
+struct LedKey {
+
+    uint32_t color;       // RGB888 color reached at the end of the key
+    uint16_t duration_ms; // length of the transition from the previous color
+    Easing   easing;
+
+};
+
+/**
+ * @brief A sequence of keyframes, played one or more times.
+ * 
+ * @details The keyframes are usually stored in flash memory:
+ * 
+ *          LedKey constexpr ALERT[] PROGMEM = {
+ *              { 0xff0000,   0, Easing::STEP        },
+ *              { 0x000000, 400, Easing::EASE_IN_OUT }
+ *          };
+ * 
+ *          espboy.pixel.play(LedTrack(ALERT, 3));
+ */
+struct LedTrack {
+
+    LedKey const *keys;
+    uint8_t       count;
+    uint8_t       loops;   // 0 to loop indefinitely
+    bool          progmem; // whether the keys are stored in flash memory
+
+    template <size_t N>
+    constexpr LedTrack(LedKey const (&keys)[N], uint8_t const loops = 1, bool const progmem = true)
+    : keys(keys), count(N), loops(loops), progmem(progmem) {}
+
+    constexpr LedTrack(LedKey const *keys, uint8_t const count, uint8_t const loops, bool const progmem)
+    : keys(keys), count(count), loops(loops), progmem(progmem) {}
+
+    constexpr LedTrack() : keys(nullptr), count(0), loops(0), progmem(false) {}
+
+};
 
 /**
  * @brief This class provides a driver to control
  *        the NeoPixel LED of the EPboy handheld.
+ * 
+ * @details Lighting effects are played by a keyframe animation engine:
+ *          the color is interpolated between keyframes with integer
+ *          arithmetic only, and the time of the next visible change is
+ *          worked out each time the LED is updated, so that update()
+ *          returns at once until then.
  */
 class NeoPixel {
 
     private:
 
-        static uint8_t const constexpr _FAST_SINE[] PROGMEM = {
-
-              0,   0,   0,   0,   1,   1,   1,   2,   2,   3,   4,   5,   6,   6,   8,   9,
-             10,  11,  12,  14,  15,  17,  18,  20,  22,  23,  25,  27,  29,  31,  33,  35,
-             38,  40,  42,  45,  47,  49,  52,  54,  57,  60,  62,  65,  68,  71,  73,  76,
-             79,  82,  85,  88,  91,  94,  97, 100, 103, 106, 109, 113, 116, 119, 122, 125
-
-        };
-
         static uint8_t constexpr _LED_PIN               = D4;
         static uint8_t constexpr _MCP23017_LED_LOCK_PIN = 9;
 
-        static uint8_t constexpr CPU_FREQ       = F_CPU / 80000000L;
-        static uint8_t constexpr CYCLES_800_T0H = CPU_FREQ * 32;
-        static uint8_t constexpr CYCLES_800_T1H = CPU_FREQ * 64;
-        static uint8_t constexpr CYCLES_800     = CPU_FREQ * 100;
+        static uint32_t constexpr _UNKNOWN    = 0xffffffff; // never matches a GRB888 color
+        static uint32_t constexpr _WHITE      = 0xffffff;
+        static uint8_t  constexpr _QUEUE_SIZE = 4;
+        static uint8_t  constexpr _FX_KEYS    = 8;          // enough for the rainbow
 
-        enum class _FX : uint8_t {
+        struct _Entry {
 
-            NONE,
-            FLASH,
-            BREATHE,
-            RAINBOW
+            LedTrack track;
+            uint32_t tint;
 
         };
 
-        Adafruit_MCP23X17 *_mcp;
+        hal::Expander       *_mcp;
+        mutable hal::LedLine _line;
+        mutable uint32_t     _grb;      // last transmitted color
+        mutable uint32_t     _color;    // color currently shown
+        mutable bool         _unlocked; // transistor lock state
 
         uint8_t _brightness;
 
-        _FX      _fx;
-        uint32_t _fx_color;
-        uint32_t _fx_start_ms;
-        uint16_t _fx_duration_ms;
-        uint16_t _fx_period_ms;
-        uint16_t _fx_offset;
-        uint8_t  _fx_count;
-        bool     _fx_looping;
-        bool     _flashing;
+        _Entry   _current;
+        uint8_t  _loops_left;
+        uint8_t  _key_index;
+        LedKey   _key;
+        uint32_t _from;         // color shown when the current key started
+        uint32_t _key_start_ms;
+        uint32_t _next_ms;      // time of the next visible change
+
+        _Entry  _queue[_QUEUE_SIZE];
+        uint8_t _queue_head;
+        uint8_t _queue_count;
 
-        uint32_t _rgb2grb(uint32_t const rgb) const;
+        LedKey _fx_keys[_FX_KEYS]; // keys of the built-in effects
 
-        void _flash();
-        void _breathe();
-        void _rainbow();
+        void _start(_Entry const &entry);
+        bool _nextKey();
+        void _loadKey();
+        void _animate(uint32_t const now);
+        void _stop();
 
-        uint8_t _sine(uint8_t const i) const;
+        uint32_t _tint(uint32_t const color) const;
 
         // color must be in GRB888 format => 0x00GGRRBB
-        void IRAM_ATTR _show(uint32_t const color) const;
+        // the transmission is skipped when the LED already shows this color,
+        // and the transistor lock is only operated when the LED is turned on or off
+        void _show(uint32_t const color) const;
 
     public:
 
@@ -78,10 +125,13 @@ class NeoPixel {
          * 
          * @param mcp Reference to the MCP23017 controller owned by the espboy instance.
          */
-        void begin(Adafruit_MCP23X17 &mcp);
+        void begin(hal::Expander &mcp);
 
         /**
          * @brief Updates the NeoPixel LED status.
+         * 
+         * @details Returns immediately as long as the animation being played
+         *          does not require the color of the LED to change.
          */
         void update();
 
@@ -106,8 +156,41 @@ class NeoPixel {
          * @brief Applies a RGB888 color to the NeoPixel LED.
          * 
          * @param color RGB888 color to apply (0 to turn off the LED).
+         * 
+         * @details The color is sent in the background and nothing is sent
+         *          at all if the LED already shows it, so that the lighting
+         *          effects cost next to nothing when the color does not change.
          */
         void show(uint32_t const color) const;
+
+        /**
+         * @brief Plays an animation right away, cancelling the queued ones.
+         * 
+         * @param track Keyframe sequence to play.
+         * @param tint  RGB888 color by which the colors of the keyframes are
+         *              multiplied (white by default), to play a single track
+         *              in different colors.
+         * 
+         * @details The first keyframe starts from the color currently shown.
+         *          At the end of the track, the LED keeps the color of its
+         *          last keyframe.
+         */
+        void play(LedTrack const &track, uint32_t const tint = 0xffffff);
+
+        /**
+         * @brief Plays an animation after the ones already queued.
+         * 
+         * @param track Keyframe sequence to play.
+         * @param tint  RGB888 color by which the colors of the keyframes are multiplied.
+         * 
+         * @return false if the queue is full (4 tracks).
+         */
+        bool queue(LedTrack const &track, uint32_t const tint = 0xffffff);
+
+        /**
+         * @brief Whether an animation is being played.
+         */
+        bool playing() const;
         
         /**
          * @brief Makes the NeoPixel LED blink.
@@ -136,6 +219,15 @@ class NeoPixel {
          */
         void rainbow(uint16_t const period_ms = 1000, uint8_t const count = 1);
 
+        #if defined(ESPBOY_HAL_HOST)
+
+        /**
+         * @brief Data line of the LED, whose stand-in records the transmitted frames.
+         */
+        hal::LedLine const &line() const { return _line; }
+
+        #endif
+
 };
 
 /*
@@ -0,0 +1,188 @@
+/**
+ * ----------------------------------------------------------------------------
+ * @file   PaletteBuffer.cpp
+ * @author Stéphane Calderoni (https://github.com/m1cr0lab)
+ * @brief  Full-screen palettized framebuffer
+ * ----------------------------------------------------------------------------
+ */
+
+#include "PaletteBuffer.h"
+#include "Color.h"
+#include "Profiler.h"
+
+#include <new>
+
+PaletteBuffer::PaletteBuffer(hal::Display &tft)
+: _tft(&tft)
+, _sprite(&tft)
+, _palette(nullptr)
+, _band { nullptr, nullptr }
+, _bpp(0)
+{}
+
+PaletteBuffer::~PaletteBuffer() { end(); }
+
+bool PaletteBuffer::begin(uint8_t const bpp) {
+
+    if (bpp != 1 && bpp != 2 && bpp != 4 && bpp != 8) return false;
+
+    end();
+
+    _sprite.setColorDepth(hal::paletteDepth(bpp));
+
+    _palette = new (std::nothrow) uint16_t[1 << bpp];
+    _band[0] = new (std::nothrow) uint16_t[WIDTH * _BAND_ROWS];
+    _band[1] = new (std::nothrow) uint16_t[WIDTH * _BAND_ROWS];
+
+    if (!_palette || !_band[0] || !_band[1] || !_sprite.createSprite(WIDTH, HEIGHT)) {
+        end();
+        return false;
+    }
+
+    _bpp = bpp;
+
+    uint16_t const n = 1 << bpp;
+    for (uint16_t i = 0; i < n; ++i) {
+        uint8_t const level = i * 0xff / (n - 1);
+        setColor(i, Color::rgb565(level, level, level));
+    }
+
+    _blit.begin(*_tft);
+
+    return true;
+
+}
+
+void PaletteBuffer::end() {
+
+    _blit.finish();
+    _sprite.deleteSprite();
+
+    delete[] _palette;
+    delete[] _band[0];
+    delete[] _band[1];
+
+    _palette = _band[0] = _band[1] = nullptr;
+    _bpp     = 0;
+
+}
+
+uint8_t      PaletteBuffer::bpp() const { return _bpp;    }
+hal::Sprite &PaletteBuffer::sprite()    { return _sprite; }
+
+void     PaletteBuffer::setColor(uint8_t const index, uint16_t const color) { _palette[index] = hal::displayOrder(color); }
+uint16_t PaletteBuffer::color(uint8_t const index) const { return hal::displayOrder(_palette[index]); }
+
+void PaletteBuffer::setPalette(uint16_t const *colors, uint16_t const count, uint8_t const first) {
+
+    for (uint16_t i = 0; i < count && first + i < (1 << _bpp); ++i) {
+        setColor(first + i, pgm_read_word(colors + i));
+    }
+
+}
+
+void PaletteBuffer::rotatePalette(uint8_t const first, uint16_t const count, int8_t const shift) {
+
+    uint16_t const size = 1 << _bpp;
+
+    if (first >= size) return;
+
+    // the range stops at the end of the palette
+    uint16_t const n = count < size - first ? count : size - first;
+
+    if (n < 2) return;
+
+    uint16_t * const p = _palette + first;
+    uint8_t steps = (shift % (int16_t)n + n) % n;
+
+    while (steps--) {
+        uint16_t const last = p[n - 1];
+        memmove(p + 1, p, (n - 1) * sizeof(uint16_t));
+        p[0] = last;
+    }
+
+}
+
+/**
+ * @note The leftmost pixel is stored in the most significant bits of each byte.
+ */
+void PaletteBuffer::_expand(uint8_t const *src, uint16_t *dst) const {
+
+    uint16_t const * const pal = _palette;
+    uint16_t const * const end = dst + WIDTH;
+
+    switch (_bpp) {
+
+        case 8:
+            while (dst < end) *dst++ = pal[*src++];
+            break;
+
+        case 4:
+            while (dst < end) {
+                uint8_t const b = *src++;
+                dst[0] = pal[b >> 4];
+                dst[1] = pal[b & 0xf];
+                dst += 2;
+            }
+            break;
+
+        case 2:
+            while (dst < end) {
+                uint8_t const b = *src++;
+                dst[0] = pal[b >> 6];
+                dst[1] = pal[b >> 4 & 0x3];
+                dst[2] = pal[b >> 2 & 0x3];
+                dst[3] = pal[b      & 0x3];
+                dst += 4;
+            }
+            break;
+
+        default:
+            while (dst < end) {
+                uint8_t const b = *src++;
+                for (uint8_t i = 0; i < 8; ++i) *dst++ = pal[b >> (7 - i) & 0x1];
+            }
+
+    }
+
+}
+
+void PaletteBuffer::flush() {
+
+    Profiler::Scope scope(Profiler::FLUSH);
+
+    uint8_t  const * const pixels = (uint8_t const *)_sprite.getBuffer();
+    uint16_t const         stride = WIDTH * _bpp >> 3;
+
+    _blit.stream(_band, WIDTH, HEIGHT, _BAND_ROWS, [&](uint8_t const band, int32_t const y) {
+
+        uint8_t  const *src = pixels + y * stride;
+        uint16_t * const dst = _band[band];
+        for (uint8_t row = 0; row < _BAND_ROWS; ++row, src += stride) _expand(src, dst + row * WIDTH);
+
+    });
+
+}
+
+void PaletteBuffer::wait() { _blit.finish(); }
+
+/*
+ * ----------------------------------------------------------------------------
+ * ESPboy Library
+ * ----------------------------------------------------------------------------
+ * Copyright (c) 2021-2022 Stéphane Calderoni (https://github.com/m1cr0lab)
+ * 
+ * This program is free software: you can redistribute it and/or modify
+ * it under the terms of the GNU General Public License as published by
+ * the Free Software Foundation, either version 3 of the License, or
+ * (at your option) any later version.
+ * 
+ * This program is distributed in the hope that it will be useful,
+ * but WITHOUT ANY WARRANTY; without even the implied warranty of
+ * MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE. See the
+ * GNU General Public License for more details.
+ * 
+ * You should have received a copy of the GNU General Public License
+ * along with this program. If not, see <https://www.gnu.org/licenses/>.
+ * ----------------------------------------------------------------------------
+ */
\ No newline at end of file
@@ -0,0 +1,164 @@
+/**
+ * ----------------------------------------------------------------------------
+ * @file   PaletteBuffer.h
+ * @author Stéphane Calderoni (https://github.com/m1cr0lab)
+ * @brief  Full-screen palettized framebuffer
+ * ----------------------------------------------------------------------------
+ */
+
+#pragma once
+
+#include "HAL.h"
+
+/**
+ * @brief This class provides a full-screen framebuffer of 1, 2, 4 or 8-bit
+ *        palette indexes, expanded to RGB565 on the fly when it is flushed.
+ * 
+ * @details A full-screen RGB565 sprite takes 32 KB, that is most of the free
+ *          heap of the ESP8266. Storing palette indexes instead divides this
+ *          cost by 16, 8, 4 or 2:
+ * 
+ *               bpp | colors | heap cost
+ *              -----+--------+----------
+ *                1  |    2   |  4 KB
+ *                2  |    4   |  6 KB
+ *                4  |   16   | 10 KB
+ *                8  |  256   | 18.5 KB
+ * 
+ *          (see heapCost()). The indexes are drawn with the whole LovyanGFX
+ *          API through sprite(), where colors are palette indexes.
+ * 
+ *          flush() expands the indexes band by band through the palette into
+ *          two small RGB565 buffers, and each band is sent to the display in
+ *          the background while the next one is expanded. Since the palette
+ *          is only applied at that time, changing or rotating it animates the
+ *          whole screen without redrawing anything.
+ * 
+ *          The last band is still being sent when flush() returns (see
+ *          hal::AsyncBlit).
+ */
+class PaletteBuffer {
+
+    private:
+
+        static uint8_t constexpr _BAND_ROWS = 4;
+
+        hal::Display  *_tft;
+        hal::Sprite    _sprite;
+        hal::AsyncBlit _blit;
+
+        uint16_t *_palette; // colors in display order
+        uint16_t *_band[2];
+        uint8_t   _bpp;
+
+        void _expand(uint8_t const *src, uint16_t *dst) const;
+
+    public:
+
+        static uint8_t constexpr WIDTH  = 128;
+        static uint8_t constexpr HEIGHT = 128;
+
+        /**
+         * @brief Heap taken by a framebuffer of a given color depth.
+         */
+        static constexpr uint32_t heapCost(uint8_t const bpp) {
+
+            return (WIDTH * HEIGHT * bpp >> 3) + (sizeof(uint16_t) << bpp) + 2 * WIDTH * _BAND_ROWS * sizeof(uint16_t);
+
+        }
+
+        /**
+         * @param tft Display controller the framebuffer is flushed to (typically espboy.tft).
+         */
+        PaletteBuffer(hal::Display &tft);
+        ~PaletteBuffer();
+
+        /**
+         * @brief Allocates the framebuffer with a grayscale palette.
+         * 
+         * @param bpp Bits per pixel: 1, 2, 4 or 8.
+         * 
+         * @return true if the allocation has succeeded.
+         */
+        bool begin(uint8_t const bpp = 4);
+
+        /**
+         * @brief Releases the framebuffer.
+         */
+        void end();
+
+        /**
+         * @brief Number of bits per pixel, 0 if the framebuffer is not allocated.
+         */
+        uint8_t bpp() const;
+
+        /**
+         * @brief Gives access to the underlying sprite and its whole drawing API.
+         * 
+         * @details Colors are palette indexes.
+         */
+        hal::Sprite &sprite();
+
+        /**
+         * @brief Sets a palette entry.
+         * 
+         * @param index Palette index.
+         * @param color Color in 16-bit format (RGB565).
+         */
+        void setColor(uint8_t const index, uint16_t const color);
+
+        /**
+         * @brief Returns a palette entry in 16-bit format (RGB565).
+         */
+        uint16_t color(uint8_t const index) const;
+
+        /**
+         * @brief Sets consecutive palette entries.
+         * 
+         * @param colors Array of RGB565 colors stored in flash memory (PROGMEM).
+         * @param count  Number of colors.
+         * @param first  Index of the first entry to set.
+         */
+        void setPalette(uint16_t const *colors, uint16_t const count, uint8_t const first = 0);
+
+        /**
+         * @brief Rotates a range of palette entries (color cycling).
+         * 
+         * @param first Index of the first entry of the range.
+         * @param count Number of entries in the range (cut at the end of the palette).
+         * @param shift Number of positions each color moves forward (or backward if negative).
+         */
+        void rotatePalette(uint8_t const first, uint16_t const count, int8_t const shift = 1);
+
+        /**
+         * @brief Sends the framebuffer to the display through the palette.
+         */
+        void flush();
+
+        /**
+         * @brief Waits for the end of the transfer started by flush().
+         */
+        void wait();
+
+};
+
+/*
+ * ----------------------------------------------------------------------------
+ * ESPboy Library
+ * ----------------------------------------------------------------------------
+ * Copyright (c) 2021-2022 Stéphane Calderoni (https://github.com/m1cr0lab)
+ * 
+ * This program is free software: you can redistribute it and/or modify
+ * it under the terms of the GNU General Public License as published by
+ * the Free Software Foundation, either version 3 of the License, or
+ * (at your option) any later version.
+ * 
+ * This program is distributed in the hope that it will be useful,
+ * but WITHOUT ANY WARRANTY; without even the implied warranty of
+ * MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE. See the
+ * GNU General Public License for more details.
+ * 
+ * You should have received a copy of the GNU General Public License
+ * along with this program. If not, see <https://www.gnu.org/licenses/>.
+ * ----------------------------------------------------------------------------
+ */
\ No newline at end of file
@@ -0,0 +1,242 @@
+/**
+ * ----------------------------------------------------------------------------
+ * @file   Particles.cpp
+ * @author Stéphane Calderoni (https://github.com/m1cr0lab)
+ * @brief  Fixed-point particle system
+ * ----------------------------------------------------------------------------
+ */
+
+#include "Particles.h"
+#include "Color.h"
+
+#include <new>
+
+Particles::Particles()
+: _x(nullptr)
+, _y(nullptr)
+, _vx(nullptr)
+, _vy(nullptr)
+, _life(nullptr)
+, _emitter(nullptr)
+, _capacity(0)
+, _count(0)
+, _emitters(nullptr)
+, _emitter_count(0)
+, _free(NO_EMITTER)
+{}
+
+Particles::~Particles() { end(); }
+
+bool Particles::begin(uint16_t const capacity, uint8_t const emitters) {
+
+    end();
+
+    if (!emitters || emitters == NO_EMITTER) return false;
+
+    _x        = new (std::nothrow) int32_t[capacity];
+    _y        = new (std::nothrow) int32_t[capacity];
+    _vx       = new (std::nothrow) int16_t[capacity];
+    _vy       = new (std::nothrow) int16_t[capacity];
+    _life     = new (std::nothrow) uint8_t[capacity];
+    _emitter  = new (std::nothrow) uint8_t[capacity];
+    _emitters = new (std::nothrow) Emitter[emitters];
+
+    if (!_x || !_y || !_vx || !_vy || !_life || !_emitter || !_emitters) { end(); return false; }
+
+    _capacity      = capacity;
+    _emitter_count = emitters;
+
+    clear();
+
+    return true;
+
+}
+
+void Particles::end() {
+
+    delete[] _x;
+    delete[] _y;
+    delete[] _vx;
+    delete[] _vy;
+    delete[] _life;
+    delete[] _emitter;
+    delete[] _emitters;
+
+    _x = _y = nullptr;
+    _vx = _vy = nullptr;
+    _life = _emitter = nullptr;
+    _emitters = nullptr;
+
+    _capacity = _count = _emitter_count = 0;
+    _free     = NO_EMITTER;
+
+}
+
+void Particles::clear() {
+
+    _count = 0;
+    _free  = NO_EMITTER;
+
+    for (uint8_t i = _emitter_count; i--;) {
+        _emitters[i].used = false;
+        _emitters[i].next = _free;
+        _free = i;
+    }
+
+}
+
+void Particles::_release(uint8_t const id) {
+
+    Emitter * const e = &_emitters[id];
+
+    e->used = false;
+    e->next = _free;
+    _free   = id;
+
+}
+
+uint8_t Particles::createEmitter(uint16_t const hue, uint8_t const size, int16_t const gravity, uint8_t const decay, bool const fade) {
+
+    if (_free == NO_EMITTER) return NO_EMITTER;
+
+    uint8_t const id = _free;
+    Emitter * const e = &_emitters[id];
+
+    _free = e->next;
+
+    for (uint8_t i = 0; i < _RAMP_SIZE; ++i) {
+        e->ramp[i] = Color::hsv2rgb565(hue, 0xff, fade ? i * 0x11 : 0xff);
+    }
+
+    e->gravity   = gravity;
+    e->decay     = decay;
+    e->size      = size;
+    e->particles = 0;
+    e->used      = true;
+
+    return id;
+
+}
+
+bool Particles::spawn(uint8_t const emitter, int16_t const x, int16_t const y, int16_t const vx, int16_t const vy) {
+
+    if (_count == _capacity || emitter >= _emitter_count || !_emitters[emitter].used) return false;
+
+    uint16_t const i = _count++;
+
+    _x[i]       = (int32_t)x << 16;
+    _y[i]       = (int32_t)y << 16;
+    _vx[i]      = vx;
+    _vy[i]      = vy;
+    _life[i]    = 0xff;
+    _emitter[i] = emitter;
+
+    _emitters[emitter].particles++;
+
+    return true;
+
+}
+
+uint16_t Particles::burst(
+    uint8_t const emitter,
+    int16_t const x,
+    int16_t const y,
+    uint16_t const count,
+    Random &rng,
+    int16_t const spread,
+    int16_t const vy_min,
+    int16_t const vy_max
+) {
+
+    uint16_t n = 0;
+
+    while (n < count && spawn(emitter, x, y, rng.range(-spread, spread), rng.range(vy_min, vy_max))) n++;
+
+    return n;
+
+}
+
+void Particles::update() {
+
+    uint16_t i = 0;
+
+    while (i < _count) {
+
+        Emitter * const e = &_emitters[_emitter[i]];
+
+        int32_t const x = _x[i] += (int32_t)_vx[i] << 8;
+        int32_t const y = _y[i] += (int32_t)_vy[i] << 8;
+        _vy[i] += e->gravity;
+
+        bool const dead = x < 0 || x >= (int32_t)WIDTH << 16 || y >= (int32_t)HEIGHT << 16 || _life[i] <= e->decay;
+
+        if (!dead) { _life[i++] -= e->decay; continue; }
+
+        e->particles--;
+
+        // the last particle takes the place of the dead one
+        uint16_t const last = --_count;
+
+        _x[i]       = _x[last];
+        _y[i]       = _y[last];
+        _vx[i]      = _vx[last];
+        _vy[i]      = _vy[last];
+        _life[i]    = _life[last];
+        _emitter[i] = _emitter[last];
+
+    }
+
+    for (uint8_t id = 0; id < _emitter_count; ++id) {
+        Emitter const &e = _emitters[id];
+        if (e.used && !e.particles) _release(id);
+    }
+
+}
+
+void Particles::draw(hal::Sprite &canvas, int16_t const dy) const {
+
+    int16_t const h = canvas.height();
+
+    for (uint16_t i = 0; i < _count; ++i) {
+
+        Emitter const &e = _emitters[_emitter[i]];
+
+        uint8_t const s = e.size;
+        int16_t const o = (s - 1) >> 1;
+        int16_t const x = (_x[i] >> 16) - o;
+        int16_t const y = (_y[i] >> 16) - o - dy;
+
+        if (y + s <= 0 || y >= h) continue;
+
+        uint16_t const color = e.ramp[_life[i] >> 4];
+
+        s == 1
+            ? canvas.drawPixel(x, y, color)
+            : canvas.fillRect(x, y, s, s, color);
+
+    }
+
+}
+
+uint16_t Particles::count() const { return _count; }
+
+/*
+ * ----------------------------------------------------------------------------
+ * ESPboy Library
+ * ----------------------------------------------------------------------------
+ * Copyright (c) 2021-2022 Stéphane Calderoni (https://github.com/m1cr0lab)
+ * 
+ * This program is free software: you can redistribute it and/or modify
+ * it under the terms of the GNU General Public License as published by
+ * the Free Software Foundation, either version 3 of the License, or
+ * (at your option) any later version.
+ * 
+ * This program is distributed in the hope that it will be useful,
+ * but WITHOUT ANY WARRANTY; without even the implied warranty of
+ * MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE. See the
+ * GNU General Public License for more details.
+ * 
+ * You should have received a copy of the GNU General Public License
+ * along with this program. If not, see <https://www.gnu.org/licenses/>.
+ * ----------------------------------------------------------------------------
+ */
\ No newline at end of file
@@ -0,0 +1,185 @@
+/**
+ * ----------------------------------------------------------------------------
+ * @file   Particles.h
+ * @author Stéphane Calderoni (https://github.com/m1cr0lab)
+ * @brief  Fixed-point particle system
+ * ----------------------------------------------------------------------------
+ */
+
+#pragma once
+
+#include "HAL.h"
+#include "Random.h"
+
+/**
+ * @brief This class animates a pool of particles spawned by emitters.
+ * 
+ * @details The ESP8266 has no FPU: positions are stored in Q16.16 and
+ *          velocities in Q8.8 fixed-point format (pixels and pixels per
+ *          tick), and each attribute is stored in its own array, so that
+ *          update() only walks through tightly packed integers. Live
+ *          particles are kept at the front of the arrays: a dying particle
+ *          is replaced by the last one.
+ * 
+ *          Particles share the settings of their emitter (size, gravity,
+ *          decay) and its color ramp, which is computed once when the emitter
+ *          is created: the color of a particle is then a mere lookup by its
+ *          remaining life instead of an HSV conversion.
+ * 
+ *          Emitters come from a fixed pool with a free list. An emitter goes
+ *          back to the pool during update() once it has no particle left, so
+ *          its particles must be spawned right after it has been created.
+ */
+class Particles {
+
+    private:
+
+        static uint8_t constexpr _RAMP_SIZE = 16;
+
+        struct Emitter {
+
+            uint16_t ramp[_RAMP_SIZE]; // colors by remaining life
+            int16_t  gravity;
+            uint8_t  decay;
+            uint8_t  size;
+            uint16_t particles;
+            uint8_t  next;             // free list link
+            bool     used;
+
+        };
+
+        int32_t *_x;
+        int32_t *_y;
+        int16_t *_vx;
+        int16_t *_vy;
+        uint8_t *_life;
+        uint8_t *_emitter;
+        uint16_t _capacity;
+        uint16_t _count;
+
+        Emitter *_emitters;
+        uint8_t  _emitter_count;
+        uint8_t  _free;
+
+        void _release(uint8_t const id);
+
+    public:
+
+        static uint8_t  constexpr WIDTH      = 128;
+        static uint8_t  constexpr HEIGHT     = 128;
+        static uint8_t  constexpr NO_EMITTER = 0xff;
+
+        /**
+         * @brief Converts pixels to the Q8.8 fixed-point format of velocities and gravity.
+         */
+        static constexpr int16_t q8(float const pixels) { return pixels * 256; }
+
+        Particles();
+        ~Particles();
+
+        /**
+         * @brief Allocates the pools.
+         * 
+         * @param capacity Maximum number of particles (14 bytes each).
+         * @param emitters Maximum number of emitters (40 bytes each).
+         * 
+         * @return true if the allocation has succeeded.
+         */
+        bool begin(uint16_t const capacity = 256, uint8_t const emitters = 16);
+
+        /**
+         * @brief Releases the pools.
+         */
+        void end();
+
+        /**
+         * @brief Kills all particles and releases all emitters.
+         */
+        void clear();
+
+        /**
+         * @brief Takes an emitter from the pool.
+         * 
+         * @param hue     Hue of the particles (ranging from 0 to 359).
+         * @param size    Side of the particles in pixels.
+         * @param gravity Vertical acceleration in Q8.8 pixels per tick per tick.
+         * @param decay   Life lost by the particles at each tick (they are born with 255).
+         * @param fade    Whether the brightness of the particles follows their life.
+         * 
+         * @return The emitter identifier, or NO_EMITTER if the pool is exhausted.
+         */
+        uint8_t createEmitter(uint16_t const hue, uint8_t const size = 2, int16_t const gravity = q8(.25f), uint8_t const decay = 3, bool const fade = true);
+
+        /**
+         * @brief Spawns a particle.
+         * 
+         * @param emitter Emitter identifier.
+         * @param x, y    Position in pixels.
+         * @param vx, vy  Velocity in Q8.8 pixels per tick.
+         * 
+         * @return false if the pool is full, or if the emitter has been released.
+         */
+        bool spawn(uint8_t const emitter, int16_t const x, int16_t const y, int16_t const vx, int16_t const vy);
+
+        /**
+         * @brief Spawns particles with random velocities.
+         * 
+         * @param spread Horizontal velocities are drawn in [-spread, spread).
+         * @param vy_min Vertical velocities are drawn in [vy_min, vy_max).
+         * @param vy_max
+         * 
+         * @return The number of particles actually spawned.
+         */
+        uint16_t burst(
+            uint8_t const emitter,
+            int16_t const x,
+            int16_t const y,
+            uint16_t const count,
+            Random &rng,
+            int16_t const spread,
+            int16_t const vy_min,
+            int16_t const vy_max
+        );
+
+        /**
+         * @brief Moves the particles by one tick, and kills those which are out
+         *        of the screen or out of life.
+         */
+        void update();
+
+        /**
+         * @brief Draws the particles.
+         * 
+         * @param canvas Target surface.
+         * @param dy     Screen row of the top edge of the canvas, when it is a band
+         *               of the screen (see DoubleBuffer).
+         */
+        void draw(hal::Sprite &canvas, int16_t const dy = 0) const;
+
+        /**
+         * @brief Number of live particles.
+         */
+        uint16_t count() const;
+
+};
+
+/*
+ * ----------------------------------------------------------------------------
+ * ESPboy Library
+ * ----------------------------------------------------------------------------
+ * Copyright (c) 2021-2022 Stéphane Calderoni (https://github.com/m1cr0lab)
+ * 
+ * This program is free software: you can redistribute it and/or modify
+ * it under the terms of the GNU General Public License as published by
+ * the Free Software Foundation, either version 3 of the License, or
+ * (at your option) any later version.
+ * 
+ * This program is distributed in the hope that it will be useful,
+ * but WITHOUT ANY WARRANTY; without even the implied warranty of
+ * MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE. See the
+ * GNU General Public License for more details.
+ * 
+ * You should have received a copy of the GNU General Public License
+ * along with this program. If not, see <https://www.gnu.org/licenses/>.
+ * ----------------------------------------------------------------------------
+ */
\ No newline at end of file
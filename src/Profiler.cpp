@@ -0,0 +1,192 @@
+/**
+ * ----------------------------------------------------------------------------
+ * @file   Profiler.cpp
+ * @author Stéphane Calderoni (https://github.com/m1cr0lab)
+ * @brief  Frame profiler with named zones
+ * ----------------------------------------------------------------------------
+ */
+
+#include "Profiler.h"
+
+static char const _BUTTONS_NAME[] PROGMEM = "btn";
+static char const _PIXEL_NAME[]   PROGMEM = "led";
+static char const _FADE_NAME[]    PROGMEM = "fade";
+static char const _FLUSH_NAME[]   PROGMEM = "flush";
+static char const _TASKS_NAME[]   PROGMEM = "task";
+
+Profiler *Profiler::_active = nullptr;
+
+Profiler::Profiler()
+: _count(0)
+, _window_start_us(0)
+, _frames(0)
+, _fps(0)
+, _out(nullptr)
+, _overlay_lines(0)
+{
+
+    zone(FPSTR(_BUTTONS_NAME));
+    zone(FPSTR(_PIXEL_NAME));
+    zone(FPSTR(_FADE_NAME));
+    zone(FPSTR(_FLUSH_NAME));
+    zone(FPSTR(_TASKS_NAME));
+
+}
+
+void Profiler::begin(Print * const out) {
+
+    _out             = out;
+    _overlay_lines   = 0;
+    _frames          = _fps = 0;
+    _window_start_us = hal::Clock::us();
+    _active          = this;
+
+}
+
+void Profiler::end() { if (_active == this) _active = nullptr; }
+
+bool Profiler::enabled() const { return _active == this; }
+
+uint8_t Profiler::zone(__FlashStringHelper const * const name) {
+
+    if (_count == MAX_ZONES) return NONE;
+
+    _zones[_count] = { name, 0, false, 0, 0, 0, {} };
+
+    return _count++;
+
+}
+
+void Profiler::start(uint8_t const zone) {
+
+    if (zone >= _count) return;
+
+    _Zone &z = _zones[zone];
+    z.open   = true;
+    z.start  = hal::Clock::cycles();
+
+}
+
+void Profiler::stop(uint8_t const zone) {
+
+    uint32_t const now = hal::Clock::cycles();
+
+    if (zone >= _count || !_zones[zone].open) return;
+
+    _Zone &z = _zones[zone];
+    uint32_t const cycles = now - z.start;
+
+    z.open   = false;
+    z.total += cycles;
+    z.calls++;
+    if (cycles > z.max) z.max = cycles;
+
+}
+
+void Profiler::update() {
+
+    if (_active != this) return;
+
+    _frames++;
+
+    uint32_t const elapsed_us = hal::Clock::us() - _window_start_us;
+    if (elapsed_us < _WINDOW_US) return;
+
+    _publish(elapsed_us);
+    if (_out) dump(*_out);
+
+}
+
+void Profiler::_publish(uint32_t const elapsed_us) {
+
+    for (uint8_t i = 0; i < _count; ++i) {
+
+        _Zone &z = _zones[i];
+        uint32_t const total_us = z.total / _CYCLES_PER_US;
+
+        z.stats.calls  = z.calls;
+        z.stats.avg_us = z.calls ? total_us / z.calls : 0;
+        z.stats.max_us = z.max / _CYCLES_PER_US;
+        z.stats.load   = (uint64_t)total_us * 1000 / elapsed_us;
+
+        z.total = z.max = z.calls = 0;
+
+    }
+
+    _fps              = _frames;
+    _frames           = 0;
+    _window_start_us += elapsed_us;
+
+    snprintf(_overlay[0], _LINE_LENGTH, "%u fps", (unsigned)_fps);
+    _overlay_lines = 1;
+
+    for (uint8_t i = 0; i < _count; ++i) if (_zones[i].stats.calls) _line(i, _overlay[_overlay_lines++]);
+
+}
+
+uint8_t                    Profiler::zones()                    const { return _count;             }
+__FlashStringHelper const *Profiler::name(uint8_t const zone)   const { return _zones[zone].name;  }
+ZoneStats const           &Profiler::stats(uint8_t const zone)  const { return _zones[zone].stats; }
+uint16_t                   Profiler::fps()                      const { return _fps;               }
+
+/**
+ * @brief Formats a zone for the overlay, on 15 characters: "flush 5210 6020".
+ */
+void Profiler::_line(uint8_t const zone, char * const buffer) const {
+
+    _Zone const &z = _zones[zone];
+
+    char name[_NAME_LENGTH + 1];
+    strncpy_P(name, (PGM_P)z.name, _NAME_LENGTH);
+    name[_NAME_LENGTH] = 0;
+
+    uint32_t const avg = z.stats.avg_us < 9999 ? z.stats.avg_us : 9999;
+    uint32_t const max = z.stats.max_us < 9999 ? z.stats.max_us : 9999;
+
+    snprintf(buffer, _LINE_LENGTH, "%-5s%5lu%5lu", name, (unsigned long)avg, (unsigned long)max);
+
+}
+
+void Profiler::dump(Print &out) const {
+
+    char buffer[24];
+
+    snprintf(buffer, sizeof(buffer), "fps %u", (unsigned)_fps);
+    out.print(buffer);
+
+    for (uint8_t i = 0; i < _count; ++i) {
+
+        ZoneStats const &s = _zones[i].stats;
+        if (!s.calls) continue;
+
+        out.print(" | ");
+        out.print(_zones[i].name);
+        snprintf(buffer, sizeof(buffer), " %lu/%lu", (unsigned long)s.avg_us, (unsigned long)s.max_us);
+        out.print(buffer);
+
+    }
+
+    out.println();
+
+}
+
+/*
+ * ----------------------------------------------------------------------------
+ * ESPboy Library
+ * ----------------------------------------------------------------------------
+ * Copyright (c) 2021-2022 Stéphane Calderoni (https://github.com/m1cr0lab)
+ * 
+ * This program is free software: you can redistribute it and/or modify
+ * it under the terms of the GNU General Public License as published by
+ * the Free Software Foundation, either version 3 of the License, or
+ * (at your option) any later version.
+ * 
+ * This program is distributed in the hope that it will be useful,
+ * but WITHOUT ANY WARRANTY; without even the implied warranty of
+ * MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE. See the
+ * GNU General Public License for more details.
+ * 
+ * You should have received a copy of the GNU General Public License
+ * along with this program. If not, see <https://www.gnu.org/licenses/>.
+ * ----------------------------------------------------------------------------
+ */
\ No newline at end of file
@@ -0,0 +1,221 @@
+/**
+ * ----------------------------------------------------------------------------
+ * @file   Profiler.h
+ * @author Stéphane Calderoni (https://github.com/m1cr0lab)
+ * @brief  Frame profiler with named zones
+ * ----------------------------------------------------------------------------
+ */
+
+#pragma once
+
+#include <Arduino.h>
+#include "HAL.h"
+
+/**
+ * @brief Time spent in a zone over the last second.
+ */
+struct ZoneStats {
+
+    uint16_t calls;  // number of times the zone was entered
+    uint32_t avg_us; // average time per call
+    uint32_t max_us; // longest call
+    uint16_t load;   // share of the second, in per mille
+
+};
+
+/**
+ * @brief This class measures the time spent in named zones of the code,
+ *        with the CPU cycle counter.
+ * 
+ * @details The library reports its own phases in the built-in zones (button
+ *          reading, NeoPixel update, backlight fade, transfer of the screen
+ *          buffers to the display, and scheduled tasks), and the game
+ *          declares its own:
+ * 
+ *            uint8_t const AI = espboy.profiler.zone(F("ai"));
+ * 
+ *            void think() {
+ *                Profiler::Scope scope(AI);
+ *                ...
+ *            }
+ * 
+ *          The measurements are aggregated over one second, after which they
+ *          are published as ZoneStats, written to the serial port if asked
+ *          to, and can be drawn into a corner of the screen with draw(). The
+ *          overlay text is formatted once per second, and stays valid for the
+ *          display lists of a StripRenderer.
+ * 
+ *          As long as begin() has not been called, entering a zone costs
+ *          nothing more than checking a pointer. Zones can be nested, but a
+ *          zone can't be entered again before it has been left.
+ */
+class Profiler {
+
+    public:
+
+        static uint8_t constexpr MAX_ZONES = 12;
+
+        // built-in zones
+        static uint8_t constexpr BUTTONS = 0;
+        static uint8_t constexpr PIXEL   = 1;
+        static uint8_t constexpr FADE    = 2;
+        static uint8_t constexpr FLUSH   = 3;
+        static uint8_t constexpr TASKS   = 4;
+
+        static uint8_t constexpr NONE = 0xff;
+
+    private:
+
+        static uint32_t constexpr _WINDOW_US     = 1000000;
+        static uint32_t constexpr _CYCLES_PER_US = F_CPU / 1000000;
+        static uint8_t  constexpr _NAME_LENGTH   = 5;  // in the overlay
+        static uint8_t  constexpr _LINE_LENGTH   = 16;
+
+        static Profiler *_active;
+
+        struct _Zone {
+
+            __FlashStringHelper const *name;
+
+            uint32_t  start;     // cycle count when the zone was entered
+            bool      open;
+            uint32_t  total;     // cycles spent over the current window
+            uint32_t  max;
+            uint16_t  calls;
+            ZoneStats stats;     // last published window
+
+        };
+
+        _Zone    _zones[MAX_ZONES];
+        uint8_t  _count;
+        uint32_t _window_start_us;
+        uint16_t _frames;
+        uint16_t _fps;
+        Print   *_out;
+
+        char    _overlay[MAX_ZONES + 1][_LINE_LENGTH]; // formatted when published
+        uint8_t _overlay_lines;
+
+        void _publish(uint32_t const elapsed_us);
+        void _line(uint8_t const zone, char * const buffer) const;
+
+    public:
+
+        /**
+         * @brief Scope of a zone: the zone is entered by the constructor and left by the destructor.
+         */
+        class Scope {
+
+            private:
+
+                uint8_t const _zone;
+
+            public:
+
+                Scope(uint8_t const zone) : _zone(zone) { if (_active) _active->start(zone); }
+                ~Scope() { if (_active) _active->stop(_zone); }
+
+        };
+
+        Profiler();
+
+        /**
+         * @brief Starts profiling.
+         * 
+         * @param out Where to write the measurements every second (typically &Serial),
+         *            or nullptr to only publish them.
+         */
+        void begin(Print * const out = nullptr);
+
+        /**
+         * @brief Stops profiling.
+         */
+        void end();
+
+        bool enabled() const;
+
+        /**
+         * @brief Declares a zone.
+         * 
+         * @param name Short name stored in flash memory, such as F("ai").
+         * 
+         * @return The zone identifier, or NONE if there are already MAX_ZONES zones.
+         */
+        uint8_t zone(__FlashStringHelper const * const name);
+
+        void start(uint8_t const zone);
+        void stop(uint8_t const zone);
+
+        /**
+         * @brief Ends a frame, and publishes the measurements once a second has elapsed.
+         * 
+         * @details Called by ESPboy::update().
+         */
+        void update();
+
+        /**
+         * @brief Number of declared zones, built-in zones included.
+         */
+        uint8_t zones() const;
+
+        __FlashStringHelper const *name(uint8_t const zone) const;
+        ZoneStats const &stats(uint8_t const zone) const;
+
+        /**
+         * @brief Number of frames over the last second.
+         */
+        uint16_t fps() const;
+
+        /**
+         * @brief Writes the measurements of the last second on a single line:
+         * 
+         *          fps 60 | btn 42/120 | led 3/9 | flush 5210/6020
+         * 
+         *        with the average and longest time per call, in microseconds,
+         *        of the zones entered during that second.
+         */
+        void dump(Print &out) const;
+
+        /**
+         * @brief Draws the measurements of the last second (average and longest
+         *        time per call, in microseconds) as an overlay.
+         * 
+         * @param canvas Drawing surface (espboy.tft, a sprite, a FrameBuffer...).
+         * @param x      Abscissa of the top left corner.
+         * @param y      Ordinate of the top left corner.
+         */
+        template <typename Canvas>
+        void draw(Canvas &canvas, int16_t const x = 0, int16_t const y = 0) const;
+
+};
+
+template <typename Canvas>
+void Profiler::draw(Canvas &canvas, int16_t const x, int16_t const y) const {
+
+    canvas.setTextColor(TFT_WHITE, TFT_BLACK);
+    canvas.setTextDatum(0); // top left
+
+    for (uint8_t i = 0; i < _overlay_lines; ++i) canvas.drawString(_overlay[i], x, y + (i << 3));
+
+}
+
+/*
+ * ----------------------------------------------------------------------------
+ * ESPboy Library
+ * ----------------------------------------------------------------------------
+ * Copyright (c) 2021-2022 Stéphane Calderoni (https://github.com/m1cr0lab)
+ * 
+ * This program is free software: you can redistribute it and/or modify
+ * it under the terms of the GNU General Public License as published by
+ * the Free Software Foundation, either version 3 of the License, or
+ * (at your option) any later version.
+ * 
+ * This program is distributed in the hope that it will be useful,
+ * but WITHOUT ANY WARRANTY; without even the implied warranty of
+ * MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE. See the
+ * GNU General Public License for more details.
+ * 
+ * You should have received a copy of the GNU General Public License
+ * along with this program. If not, see <https://www.gnu.org/licenses/>.
+ * ----------------------------------------------------------------------------
+ */
\ No newline at end of file
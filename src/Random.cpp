@@ -0,0 +1,51 @@
+/**
+ * ----------------------------------------------------------------------------
+ * @file   Random.cpp
+ * @author Stéphane Calderoni (https://github.com/m1cr0lab)
+ * @brief  Fast pseudo-random number generator
+ * ----------------------------------------------------------------------------
+ */
+
+#include "Random.h"
+
+Random::Random(uint32_t const seed) { this->seed(seed); }
+
+void     Random::seed(uint32_t const seed) { _state = seed ? seed : 0x2545f491; }
+uint32_t Random::state() const             { return _state; }
+
+uint32_t Random::next() {
+
+    uint32_t x = _state;
+
+    x ^= x << 13;
+    x ^= x >> 17;
+    x ^= x << 5;
+
+    return _state = x;
+
+}
+
+uint32_t Random::below(uint32_t const max) { return ((uint64_t)next() * max) >> 32; }
+
+int32_t Random::range(int32_t const min, int32_t const max) { return min < max ? min + (int32_t)below(max - min) : min; }
+
+/*
+ * ----------------------------------------------------------------------------
+ * ESPboy Library
+ * ----------------------------------------------------------------------------
+ * Copyright (c) 2021-2022 Stéphane Calderoni (https://github.com/m1cr0lab)
+ * 
+ * This program is free software: you can redistribute it and/or modify
+ * it under the terms of the GNU General Public License as published by
+ * the Free Software Foundation, either version 3 of the License, or
+ * (at your option) any later version.
+ * 
+ * This program is distributed in the hope that it will be useful,
+ * but WITHOUT ANY WARRANTY; without even the implied warranty of
+ * MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE. See the
+ * GNU General Public License for more details.
+ * 
+ * You should have received a copy of the GNU General Public License
+ * along with this program. If not, see <https://www.gnu.org/licenses/>.
+ * ----------------------------------------------------------------------------
+ */
\ No newline at end of file
@@ -0,0 +1,77 @@
+/**
+ * ----------------------------------------------------------------------------
+ * @file   Random.h
+ * @author Stéphane Calderoni (https://github.com/m1cr0lab)
+ * @brief  Fast pseudo-random number generator
+ * ----------------------------------------------------------------------------
+ */
+
+#pragma once
+
+#include <Arduino.h>
+
+/**
+ * @brief Marsaglia's xorshift32 generator.
+ * 
+ * @details A handful of shifts and XORs per number, and bounded numbers are
+ *          obtained with a multiplication instead of a division, which makes
+ *          it much cheaper than random() on the ESP8266. Its whole state is
+ *          the 32-bit seed, so a sequence can be replayed at will.
+ */
+class Random {
+
+    private:
+
+        uint32_t _state;
+
+    public:
+
+        Random(uint32_t const seed = 0x2545f491);
+
+        /**
+         * @brief Restarts the sequence (a null seed is replaced by a fixed one).
+         */
+        void seed(uint32_t const seed);
+
+        /**
+         * @brief Current state, to be given to seed() to replay the sequence from here.
+         */
+        uint32_t state() const;
+
+        /**
+         * @brief Returns a 32-bit random number.
+         */
+        uint32_t next();
+
+        /**
+         * @brief Returns a random number in [0, max).
+         */
+        uint32_t below(uint32_t const max);
+
+        /**
+         * @brief Returns a random number in [min, max).
+         */
+        int32_t range(int32_t const min, int32_t const max);
+
+};
+
+/*
+ * ----------------------------------------------------------------------------
+ * ESPboy Library
+ * ----------------------------------------------------------------------------
+ * Copyright (c) 2021-2022 Stéphane Calderoni (https://github.com/m1cr0lab)
+ * 
+ * This program is free software: you can redistribute it and/or modify
+ * it under the terms of the GNU General Public License as published by
+ * the Free Software Foundation, either version 3 of the License, or
+ * (at your option) any later version.
+ * 
+ * This program is distributed in the hope that it will be useful,
+ * but WITHOUT ANY WARRANTY; without even the implied warranty of
+ * MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE. See the
+ * GNU General Public License for more details.
+ * 
+ * You should have received a copy of the GNU General Public License
+ * along with this program. If not, see <https://www.gnu.org/licenses/>.
+ * ----------------------------------------------------------------------------
+ */
\ No newline at end of file
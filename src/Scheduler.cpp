@@ -0,0 +1,286 @@
+/**
+ * ----------------------------------------------------------------------------
+ * @file   Scheduler.cpp
+ * @author Stéphane Calderoni (https://github.com/m1cr0lab)
+ * @brief  Cooperative scheduler of timers and background jobs
+ * ----------------------------------------------------------------------------
+ */
+
+#include "Scheduler.h"
+#include "Profiler.h"
+
+Scheduler::Scheduler()
+: _count(0)
+, _budget_us(0)
+, _running(false)
+, _now_ms(0)
+, _ran(0)
+, _deferred(0)
+{
+
+    for (uint8_t i = 0; i < MAX_TASKS; ++i) _tasks[i].used = false;
+
+}
+
+uint8_t Scheduler::after(uint32_t const delay_ms, Callback const callback, TaskPriority const priority) {
+
+    uint8_t const slot = _add(delay_ms, 0, priority);
+    if (slot != NO_TASK) _tasks[slot].callback = callback;
+
+    return slot;
+
+}
+
+uint8_t Scheduler::after(uint32_t const delay_ms, ContextCallback const callback, void * const context, TaskPriority const priority) {
+
+    uint8_t const slot = _add(delay_ms, 0, priority);
+    if (slot != NO_TASK) { _tasks[slot].context_callback = callback; _tasks[slot].context = context; }
+
+    return slot;
+
+}
+
+uint8_t Scheduler::every(uint32_t const period_ms, Callback const callback, TaskPriority const priority) {
+
+    uint8_t const slot = _add(period_ms ? period_ms : 1, period_ms ? period_ms : 1, priority);
+    if (slot != NO_TASK) _tasks[slot].callback = callback;
+
+    return slot;
+
+}
+
+uint8_t Scheduler::every(uint32_t const period_ms, ContextCallback const callback, void * const context, TaskPriority const priority) {
+
+    uint8_t const slot = _add(period_ms ? period_ms : 1, period_ms ? period_ms : 1, priority);
+    if (slot != NO_TASK) { _tasks[slot].context_callback = callback; _tasks[slot].context = context; }
+
+    return slot;
+
+}
+
+bool Scheduler::cancel(uint8_t const task) {
+
+    if (!scheduled(task)) return false;
+
+    _remove(task);
+    _tasks[task].used = false;
+
+    return true;
+
+}
+
+bool Scheduler::scheduled(uint8_t const task) const { return task < MAX_TASKS && _tasks[task].used; }
+
+bool Scheduler::reschedule(uint8_t const task, uint32_t const delay_ms) {
+
+    if (!scheduled(task)) return false;
+
+    _remove(task);
+    _tasks[task].due_ms = millis() + delay_ms;
+    _push(task);
+
+    return true;
+
+}
+
+uint32_t Scheduler::remaining(uint8_t const task) const {
+
+    if (!scheduled(task)) return 0;
+
+    int32_t const left = _tasks[task].due_ms - millis();
+
+    return left > 0 ? left : 0;
+
+}
+
+uint8_t Scheduler::count()    const { return _count;    }
+uint8_t Scheduler::ran()      const { return _ran;      }
+uint8_t Scheduler::deferred() const { return _deferred; }
+
+void Scheduler::setBudget(uint16_t const budget_us) { _budget_us = budget_us; }
+
+void Scheduler::run() { run(micros()); }
+
+void Scheduler::run(uint32_t const frame_start_us) {
+
+    _ran = _deferred = 0;
+
+    if (!_count) return;
+
+    _now_ms = millis();
+
+    // nothing is due: a single comparison
+    if ((int32_t)(_tasks[_heap[0]].due_ms - _now_ms) > 0) return;
+
+    Profiler::Scope scope(Profiler::TASKS);
+
+    uint8_t deferred[MAX_TASKS];
+
+    _running = true;
+
+    while (_count) {
+
+        uint8_t const slot = _heap[0];
+        _Task        &task = _tasks[slot];
+
+        if ((int32_t)(task.due_ms - _now_ms) > 0) break;
+
+        _pop();
+
+        if (task.priority == TaskPriority::BACKGROUND && _budget_us && micros() - frame_start_us >= _budget_us) {
+            deferred[_deferred++] = slot;
+            continue;
+        }
+
+        // the task is released or rescheduled before it is run, so that it can cancel itself
+        Callback        const callback         = task.callback;
+        ContextCallback const context_callback = task.context_callback;
+        void          * const context          = task.context;
+
+        if (task.period_ms) {
+            task.due_ms += task.period_ms;
+            if ((int32_t)(task.due_ms - _now_ms) <= 0) task.due_ms = _now_ms + task.period_ms;
+            _push(slot);
+        } else task.used = false;
+
+        _ran++;
+
+        if (callback) callback(); else context_callback(context);
+
+    }
+
+    _running = false;
+
+    // the deferred tasks keep their deadline, and come first at the next frame
+    // (unless they have been cancelled meanwhile)
+    for (uint8_t i = 0; i < _deferred; ++i) {
+        uint8_t const slot = deferred[i];
+        if (_tasks[slot].used && _tasks[slot].heap_index == NO_TASK) _push(slot);
+    }
+
+}
+
+uint8_t Scheduler::_add(uint32_t const delay_ms, uint32_t const period_ms, TaskPriority const priority) {
+
+    uint8_t slot = 0;
+    while (slot < MAX_TASKS && _tasks[slot].used) slot++;
+
+    if (slot == MAX_TASKS) return NO_TASK;
+
+    _Task &task = _tasks[slot];
+
+    task.callback         = nullptr;
+    task.context_callback = nullptr;
+    task.context          = nullptr;
+    task.due_ms           = millis() + delay_ms;
+    task.period_ms        = period_ms;
+    task.priority         = priority;
+    task.used             = true;
+
+    // a task created by a running task waits for the next frame
+    if (_running && (int32_t)(task.due_ms - _now_ms) <= 0) task.due_ms = _now_ms + 1;
+
+    _push(slot);
+
+    return slot;
+
+}
+
+bool Scheduler::_before(uint8_t const a, uint8_t const b) const {
+
+    return (int32_t)(_tasks[a].due_ms - _tasks[b].due_ms) < 0;
+
+}
+
+void Scheduler::_place(uint8_t const i, uint8_t const slot) {
+
+    _heap[i] = slot;
+    _tasks[slot].heap_index = i;
+
+}
+
+void Scheduler::_push(uint8_t const slot) {
+
+    _place(_count, slot);
+    _siftUp(_count++);
+
+}
+
+uint8_t Scheduler::_pop() {
+
+    uint8_t const slot = _heap[0];
+    _remove(slot);
+
+    return slot;
+
+}
+
+void Scheduler::_remove(uint8_t const slot) {
+
+    uint8_t const i = _tasks[slot].heap_index;
+
+    if (i == NO_TASK) return; // deferred by run()
+
+    _tasks[slot].heap_index = NO_TASK;
+
+    if (i != --_count) {
+        uint8_t const last = _heap[_count];
+        _place(i, last);
+        _siftUp(i);
+        _siftDown(_tasks[last].heap_index);
+    }
+
+}
+
+void Scheduler::_siftUp(uint8_t i) {
+
+    uint8_t const slot = _heap[i];
+
+    while (i) {
+        uint8_t const parent = (i - 1) >> 1;
+        if (!_before(slot, _heap[parent])) break;
+        _place(i, _heap[parent]);
+        i = parent;
+    }
+
+    _place(i, slot);
+
+}
+
+void Scheduler::_siftDown(uint8_t i) {
+
+    uint8_t const slot = _heap[i];
+
+    for (;;) {
+        uint8_t child = (i << 1) + 1;
+        if (child >= _count) break;
+        if (child + 1 < _count && _before(_heap[child + 1], _heap[child])) child++;
+        if (!_before(_heap[child], slot)) break;
+        _place(i, _heap[child]);
+        i = child;
+    }
+
+    _place(i, slot);
+
+}
+
+/*
+ * ----------------------------------------------------------------------------
+ * ESPboy Library
+ * ----------------------------------------------------------------------------
+ * Copyright (c) 2021-2022 Stéphane Calderoni (https://github.com/m1cr0lab)
+ * 
+ * This program is free software: you can redistribute it and/or modify
+ * it under the terms of the GNU General Public License as published by
+ * the Free Software Foundation, either version 3 of the License, or
+ * (at your option) any later version.
+ * 
+ * This program is distributed in the hope that it will be useful,
+ * but WITHOUT ANY WARRANTY; without even the implied warranty of
+ * MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE. See the
+ * GNU General Public License for more details.
+ * 
+ * You should have received a copy of the GNU General Public License
+ * along with this program. If not, see <https://www.gnu.org/licenses/>.
+ * ----------------------------------------------------------------------------
+ */
\ No newline at end of file
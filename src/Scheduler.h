@@ -0,0 +1,218 @@
+/**
+ * ----------------------------------------------------------------------------
+ * @file   Scheduler.h
+ * @author Stéphane Calderoni (https://github.com/m1cr0lab)
+ * @brief  Cooperative scheduler of timers and background jobs
+ * ----------------------------------------------------------------------------
+ */
+
+#pragma once
+
+#include <Arduino.h>
+
+/**
+ * @brief How a task behaves when the frame runs out of time.
+ */
+enum class TaskPriority : uint8_t {
+
+    NORMAL,    // runs as soon as it is due
+    BACKGROUND // deferred to the next frames as long as the budget is spent
+
+};
+
+/**
+ * @brief This class calls functions after a delay, or periodically, from
+ *        within ESPboy::update().
+ * 
+ * @details Instead of each part of a game polling millis() to find out
+ *          whether its time has come, the tasks are kept in a binary
+ *          min-heap ordered by deadline: a frame in which nothing is due
+ *          costs a single comparison, and due tasks are run earliest
+ *          deadline first.
+ * 
+ *            void step() { ... }
+ * 
+ *            void setup() {
+ *                espboy.begin();
+ *                espboy.scheduler.every(60, step);
+ *            }
+ * 
+ *          Periodic tasks keep their phase: a late task is run once, and
+ *          the missed periods are skipped. A task may cancel itself or
+ *          schedule other tasks, but those created while the tasks are
+ *          being run wait for the next frame if they are due at once.
+ * 
+ *          With a time budget (see setBudget()), the background tasks
+ *          (asset decompression, saves, cosmetic effects...) are only
+ *          started while the frame, counted from its start, has not used
+ *          it up. The others are left in the heap, with their deadline, and
+ *          come first at the next frame.
+ * 
+ *          The capacity is fixed, and nothing is allocated.
+ */
+class Scheduler {
+
+    public:
+
+        static uint8_t constexpr MAX_TASKS = 16;
+        static uint8_t constexpr NO_TASK   = 0xff;
+
+        using Callback        = void (*)();
+        using ContextCallback = void (*)(void *context);
+
+    private:
+
+        struct _Task {
+
+            Callback        callback;
+            ContextCallback context_callback;
+            void           *context;
+            uint32_t        due_ms;
+            uint32_t        period_ms; // 0 for a one-shot task
+            TaskPriority    priority;
+            uint8_t         heap_index;
+            bool            used;
+
+        };
+
+        _Task    _tasks[MAX_TASKS];
+        uint8_t  _heap[MAX_TASKS]; // task slots, ordered by deadline
+        uint8_t  _count;
+        uint16_t _budget_us;
+        bool     _running;
+        uint32_t _now_ms;          // time at which the tasks are being run
+        uint8_t  _ran;
+        uint8_t  _deferred;
+
+        uint8_t _add(uint32_t const delay_ms, uint32_t const period_ms, TaskPriority const priority);
+        void    _push(uint8_t const slot);
+        uint8_t _pop();
+        void    _remove(uint8_t const slot);
+        bool    _before(uint8_t const a, uint8_t const b) const;
+        void    _siftUp(uint8_t i);
+        void    _siftDown(uint8_t i);
+        void    _place(uint8_t const i, uint8_t const slot);
+
+    public:
+
+        Scheduler();
+
+        /**
+         * @brief Calls a function once, after a delay.
+         * 
+         * @param delay_ms Delay in milliseconds.
+         * @param callback Function to call.
+         * @param priority TaskPriority::BACKGROUND for a task that may be deferred.
+         * 
+         * @return The task identifier, or NO_TASK if there are already MAX_TASKS tasks.
+         */
+        uint8_t after(uint32_t const delay_ms, Callback const callback, TaskPriority const priority = TaskPriority::NORMAL);
+
+        /**
+         * @brief Calls a function once, after a delay, with a context pointer.
+         */
+        uint8_t after(uint32_t const delay_ms, ContextCallback const callback, void * const context, TaskPriority const priority = TaskPriority::NORMAL);
+
+        /**
+         * @brief Calls a function periodically, the first time after one period.
+         * 
+         * @param period_ms Period in milliseconds (at least 1).
+         * @param callback  Function to call.
+         * @param priority  TaskPriority::BACKGROUND for a task that may be deferred.
+         * 
+         * @return The task identifier, or NO_TASK if there are already MAX_TASKS tasks.
+         */
+        uint8_t every(uint32_t const period_ms, Callback const callback, TaskPriority const priority = TaskPriority::NORMAL);
+
+        /**
+         * @brief Calls a function periodically, with a context pointer.
+         */
+        uint8_t every(uint32_t const period_ms, ContextCallback const callback, void * const context, TaskPriority const priority = TaskPriority::NORMAL);
+
+        /**
+         * @brief Cancels a task.
+         * 
+         * @return false if the task was not scheduled (a one-shot task is
+         *         released once it has been run).
+         */
+        bool cancel(uint8_t const task);
+
+        /**
+         * @brief Whether a task is scheduled.
+         */
+        bool scheduled(uint8_t const task) const;
+
+        /**
+         * @brief Postpones a task, which is then due after the given delay.
+         */
+        bool reschedule(uint8_t const task, uint32_t const delay_ms);
+
+        /**
+         * @brief Milliseconds left before a task is due (0 if it is due, or not scheduled).
+         */
+        uint32_t remaining(uint8_t const task) const;
+
+        /**
+         * @brief Number of scheduled tasks.
+         */
+        uint8_t count() const;
+
+        /**
+         * @brief Sets the time budget of each frame.
+         * 
+         * @param budget_us Time in microseconds, from the start of the frame,
+         *                  after which the background tasks are deferred (0,
+         *                  the default, for no limit).
+         * 
+         * @details The time already spent on the frame before the tasks are
+         *          run (game logic, input, LED...) counts against the budget.
+         */
+        void setBudget(uint16_t const budget_us);
+
+        /**
+         * @brief Runs the due tasks, earliest deadline first.
+         * 
+         * @param frame_start_us Time in microseconds at which the frame started,
+         *                       from which the budget is counted.
+         * 
+         * @details Called by ESPboy::update(), with FramePacer::frameStart().
+         */
+        void run(uint32_t const frame_start_us);
+
+        /**
+         * @brief Runs the due tasks, with the budget counted from now on.
+         */
+        void run();
+
+        /**
+         * @brief Number of tasks run by the last run().
+         */
+        uint8_t ran() const;
+
+        /**
+         * @brief Number of background tasks deferred by the last run().
+         */
+        uint8_t deferred() const;
+
+};
+
+/*
+ * ----------------------------------------------------------------------------
+ * ESPboy Library
+ * ----------------------------------------------------------------------------
+ * Copyright (c) 2021-2022 Stéphane Calderoni (https://github.com/m1cr0lab)
+ * 
+ * This program is free software: you can redistribute it and/or modify
+ * it under the terms of the GNU General Public License as published by
+ * the Free Software Foundation, either version 3 of the License, or
+ * (at your option) any later version.
+ * 
+ * This program is distributed in the hope that it will be useful,
+ * but WITHOUT ANY WARRANTY; without even the implied warranty of
+ * MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE. See the
+ * GNU General Public License for more details.
+ * 
+ * You should have received a copy of the GNU General Public License
+ * along with this program. If not, see <https://www.gnu.org/licenses/>.
+ * ----------------------------------------------------------------------------
+ */
\ No newline at end of file
@@ -0,0 +1,268 @@
+/**
+ * ----------------------------------------------------------------------------
+ * @file   StripRenderer.cpp
+ * @author Stéphane Calderoni (https://github.com/m1cr0lab)
+ * @brief  Display list rendered strip by strip
+ * ----------------------------------------------------------------------------
+ */
+
+#include "StripRenderer.h"
+#include "Profiler.h"
+
+#include <new>
+
+StripRenderer::StripRenderer(hal::Display &tft)
+: _tft(&tft)
+, _strip { hal::Sprite(&tft), hal::Sprite(&tft) }
+, _list(nullptr)
+, _capacity(0)
+, _count(0)
+, _dropped(0)
+, _rows(0)
+, _background(0)
+, _text_fg(0xffff)
+, _text_bg(0)
+, _text_filled(false)
+, _text_datum(0)
+{}
+
+StripRenderer::~StripRenderer() { end(); }
+
+bool StripRenderer::begin(uint8_t const capacity, uint8_t const rows) {
+
+    if (!rows || HEIGHT % rows) return false;
+
+    end();
+
+    _list = new (std::nothrow) Command[capacity];
+    if (!_list) return false;
+
+    for (uint8_t i = 0; i < 2; ++i) {
+        _strip[i].setColorDepth(16);
+        if (!_strip[i].createSprite(WIDTH, rows)) { end(); return false; }
+    }
+
+    _blit.begin(*_tft);
+
+    _capacity = capacity;
+    _rows     = rows;
+    _count    = 0;
+    _dropped  = 0;
+
+    return true;
+
+}
+
+void StripRenderer::end() {
+
+    _blit.finish();
+
+    _strip[0].deleteSprite();
+    _strip[1].deleteSprite();
+
+    delete[] _list;
+    _list     = nullptr;
+    _capacity = _count = _rows = 0;
+
+}
+
+void StripRenderer::clear(uint16_t const color) {
+
+    _background = color;
+    _count      = 0;
+
+}
+
+uint8_t  StripRenderer::size()            const { return _count;   }
+uint16_t StripRenderer::droppedCommands() const { return _dropped; }
+
+StripRenderer::Command *StripRenderer::_push(Op const op, int16_t const top, int16_t const bottom) {
+
+    if (bottom <= 0 || top >= HEIGHT) return nullptr; // off screen
+    if (_count == _capacity) { _dropped++; return nullptr; }
+
+    Command * const c = &_list[_count++];
+
+    c->op     = op;
+    c->top    = top;
+    c->bottom = bottom;
+
+    return c;
+
+}
+
+void StripRenderer::fillRect(int32_t const x, int32_t const y, int32_t const w, int32_t const h, uint16_t const color) {
+
+    Command * const c = _push(Op::FILL_RECT, y, y + h); if (!c) return;
+    c->x = x; c->y = y; c->w = w; c->h = h;
+    c->color = color;
+
+}
+
+void StripRenderer::drawRect(int32_t const x, int32_t const y, int32_t const w, int32_t const h, uint16_t const color) {
+
+    Command * const c = _push(Op::DRAW_RECT, y, y + h); if (!c) return;
+    c->x = x; c->y = y; c->w = w; c->h = h;
+    c->color = color;
+
+}
+
+void StripRenderer::fillRoundRect(int32_t const x, int32_t const y, int32_t const w, int32_t const h, int32_t const r, uint16_t const color) {
+
+    Command * const c = _push(Op::FILL_ROUND_RECT, y, y + h); if (!c) return;
+    c->x = x; c->y = y; c->w = w; c->h = h;
+    c->color = color;
+    c->alt   = r;
+
+}
+
+void StripRenderer::drawBitmap(int32_t const x, int32_t const y, uint8_t const *bitmap, int32_t const w, int32_t const h, uint16_t const color) {
+
+    Command * const c = _push(Op::BITMAP, y, y + h); if (!c) return;
+    c->x = x; c->y = y; c->w = w; c->h = h;
+    c->color = color;
+    c->data  = bitmap;
+
+}
+
+void StripRenderer::pushImage(int32_t const x, int32_t const y, int32_t const w, int32_t const h, uint16_t const *data) {
+
+    Command * const c = _push(Op::IMAGE, y, y + h); if (!c) return;
+    c->x = x; c->y = y; c->w = w; c->h = h;
+    c->data = data;
+
+}
+
+void StripRenderer::pushImage(int32_t const x, int32_t const y, int32_t const w, int32_t const h, uint16_t const *data, uint16_t const transparent) {
+
+    Command * const c = _push(Op::IMAGE_KEYED, y, y + h); if (!c) return;
+    c->x = x; c->y = y; c->w = w; c->h = h;
+    c->alt  = transparent;
+    c->data = data;
+
+}
+
+void StripRenderer::drawAsset(Asset const &asset, int32_t const x, int32_t const y, uint16_t const color) {
+
+    Command * const c = _push(Op::ASSET, y, y + asset.height()); if (!c) return;
+    c->x = x; c->y = y;
+    c->color = color;
+    c->data  = asset.data();
+
+}
+
+void StripRenderer::setTextColor(uint16_t const color)                 { _text_fg = color; _text_filled = false; }
+void StripRenderer::setTextColor(uint16_t const fg, uint16_t const bg) { _text_fg = fg; _text_bg = bg; _text_filled = true; }
+void StripRenderer::setTextDatum(uint8_t const datum)                  { _text_datum = datum; }
+
+/**
+ * @note LovyanGFX text datums: bits 2-3 give the vertical alignment
+ *       (top, middle, bottom), and bit 4 the baseline alignment.
+ */
+void StripRenderer::_pushText(Op const op, void const *text, int32_t const x, int32_t const y) {
+
+    int32_t const h   = _strip[0].fontHeight();
+    int32_t const top = _text_datum & 0x10 ? y - h                 // baseline: be conservative
+                      : (_text_datum & 0xc) == 4 ? y - (h >> 1)
+                      : (_text_datum & 0xc) == 8 ? y - h
+                      : y;
+
+    Command * const c = _push(op, top, top + (_text_datum & 0x10 ? h << 1 : h)); if (!c) return;
+    c->x = x; c->y = y;
+    c->datum  = _text_datum;
+    c->filled = _text_filled;
+    c->color  = _text_fg;
+    c->alt    = _text_bg;
+    c->data   = text;
+
+}
+
+void StripRenderer::drawString(char const *text, int32_t const x, int32_t const y) {
+
+    _pushText(Op::TEXT, text, x, y);
+
+}
+
+void StripRenderer::drawString(__FlashStringHelper const *text, int32_t const x, int32_t const y) {
+
+    _pushText(Op::TEXT_P, text, x, y);
+
+}
+
+void StripRenderer::_draw(hal::Sprite &strip, Command const &c, int16_t const y0) const {
+
+    int32_t const y = c.y - y0;
+
+    switch (c.op) {
+
+        case Op::FILL_RECT:       strip.fillRect(c.x, y, c.w, c.h, c.color); break;
+        case Op::DRAW_RECT:       strip.drawRect(c.x, y, c.w, c.h, c.color); break;
+        case Op::FILL_ROUND_RECT: strip.fillRoundRect(c.x, y, c.w, c.h, c.alt, c.color); break;
+        case Op::BITMAP:          strip.drawBitmap(c.x, y, (uint8_t const *)c.data, c.w, c.h, c.color); break;
+        case Op::IMAGE:           strip.pushImage(c.x, y, c.w, c.h, (uint16_t const *)c.data); break;
+        case Op::IMAGE_KEYED:     strip.pushImage(c.x, y, c.w, c.h, (uint16_t const *)c.data, c.alt); break;
+        case Op::ASSET:           Asset((uint8_t const *)c.data).draw(strip, c.x, y, c.color); break;
+
+        case Op::TEXT:
+        case Op::TEXT_P:
+
+            c.filled ? strip.setTextColor(c.color, c.alt) : strip.setTextColor(c.color);
+            strip.setTextDatum(c.datum);
+
+            if (c.op == Op::TEXT) {
+                strip.drawString((char const *)c.data, c.x, y);
+            } else {
+                uint8_t len = strlen_P((PGM_P)c.data);
+                char    buffer[len + 1];
+                strncpy_P(buffer, (PGM_P)c.data, len + 1);
+                strip.drawString(buffer, c.x, y);
+            }
+
+    }
+
+}
+
+void StripRenderer::render() {
+
+    Profiler::Scope scope(Profiler::FLUSH);
+
+    uint16_t * const buffer[2] = { (uint16_t *)_strip[0].getBuffer(), (uint16_t *)_strip[1].getBuffer() };
+
+    _blit.stream(buffer, WIDTH, HEIGHT, _rows, [this](uint8_t const band, int32_t const y0) {
+
+        hal::Sprite  &strip = _strip[band];
+        int16_t const y1    = y0 + _rows;
+
+        strip.fillScreen(_background);
+
+        for (uint8_t i = 0; i < _count; ++i) {
+            Command const &c = _list[i];
+            if (c.top < y1 && c.bottom > y0) _draw(strip, c, y0);
+        }
+
+    });
+
+}
+
+void StripRenderer::wait() { _blit.finish(); }
+
+/*
+ * ----------------------------------------------------------------------------
+ * ESPboy Library
+ * ----------------------------------------------------------------------------
+ * Copyright (c) 2021-2022 Stéphane Calderoni (https://github.com/m1cr0lab)
+ * 
+ * This program is free software: you can redistribute it and/or modify
+ * it under the terms of the GNU General Public License as published by
+ * the Free Software Foundation, either version 3 of the License, or
+ * (at your option) any later version.
+ * 
+ * This program is distributed in the hope that it will be useful,
+ * but WITHOUT ANY WARRANTY; without even the implied warranty of
+ * MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE. See the
+ * GNU General Public License for more details.
+ * 
+ * You should have received a copy of the GNU General Public License
+ * along with this program. If not, see <https://www.gnu.org/licenses/>.
+ * ----------------------------------------------------------------------------
+ */
\ No newline at end of file
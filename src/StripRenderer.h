@@ -0,0 +1,176 @@
+/**
+ * ----------------------------------------------------------------------------
+ * @file   StripRenderer.h
+ * @author Stéphane Calderoni (https://github.com/m1cr0lab)
+ * @brief  Display list rendered strip by strip
+ * ----------------------------------------------------------------------------
+ */
+
+#pragma once
+
+#include "HAL.h"
+#include "Asset.h"
+
+/**
+ * @brief This class renders a full 16-bit screen without any framebuffer.
+ * 
+ * @details Instead of drawing into a 32 KB sprite, the game submits at each
+ *          frame a display list of drawing commands (rectangles, bitmaps,
+ *          images and compressed assets stored in flash memory, text). render() then rasterizes the
+ *          list into a small strip of a few rows, which is sent to the display
+ *          in the background while the next strip is rasterized, and so on
+ *          down the screen. Each strip only replays the commands that overlap
+ *          it, the others being culled by their bounding box.
+ * 
+ *          With 8-row strips, the renderer takes about 4 KB of heap plus 24
+ *          bytes per command of the display list.
+ * 
+ *          The display list only references the bitmaps, images and strings
+ *          it is given, which must remain valid until render() has returned.
+ *          The last strip is still being sent when render() returns (see
+ *          hal::AsyncBlit).
+ */
+class StripRenderer {
+
+    private:
+
+        enum class Op : uint8_t { FILL_RECT, DRAW_RECT, FILL_ROUND_RECT, BITMAP, IMAGE, IMAGE_KEYED, ASSET, TEXT, TEXT_P };
+
+        struct Command {
+
+            Op          op;
+            uint8_t     datum;
+            bool        filled;
+            int16_t     x, y, w, h;  // drawing parameters
+            int16_t     top, bottom; // vertical extent on screen
+            uint16_t    color;
+            uint16_t    alt;         // radius, transparent or background color
+            void const *data;
+
+        };
+
+        hal::Display  *_tft;
+        hal::Sprite    _strip[2];
+        hal::AsyncBlit _blit;
+
+        Command *_list;
+        uint8_t  _capacity;
+        uint8_t  _count;
+        uint16_t _dropped;
+        uint8_t  _rows;
+        uint16_t _background;
+
+        uint16_t _text_fg;
+        uint16_t _text_bg;
+        bool     _text_filled;
+        uint8_t  _text_datum;
+
+        Command *_push(Op const op, int16_t const top, int16_t const bottom);
+        void     _pushText(Op const op, void const *text, int32_t const x, int32_t const y);
+        void     _draw(hal::Sprite &strip, Command const &c, int16_t const y0) const;
+
+    public:
+
+        static uint8_t constexpr WIDTH  = 128;
+        static uint8_t constexpr HEIGHT = 128;
+
+        /**
+         * @param tft Display controller the strips are sent to (typically espboy.tft).
+         */
+        StripRenderer(hal::Display &tft);
+        ~StripRenderer();
+
+        /**
+         * @brief Allocates the strips and the display list.
+         * 
+         * @param capacity Maximum number of commands per frame.
+         * @param rows     Height of the strips (a divisor of 128).
+         * 
+         * @return true if the allocation has succeeded.
+         */
+        bool begin(uint8_t const capacity = 64, uint8_t const rows = 8);
+
+        /**
+         * @brief Releases the strips and the display list.
+         */
+        void end();
+
+        /**
+         * @brief Starts a new display list.
+         * 
+         * @param color Background color of the screen.
+         */
+        void clear(uint16_t const color = 0);
+
+        /**
+         * @brief Number of commands in the display list.
+         */
+        uint8_t size() const;
+
+        /**
+         * @brief Number of commands dropped since begin() because the display list was full.
+         */
+        uint16_t droppedCommands() const;
+
+        void fillRect(int32_t const x, int32_t const y, int32_t const w, int32_t const h, uint16_t const color);
+        void drawRect(int32_t const x, int32_t const y, int32_t const w, int32_t const h, uint16_t const color);
+        void fillRoundRect(int32_t const x, int32_t const y, int32_t const w, int32_t const h, int32_t const r, uint16_t const color);
+
+        /**
+         * @brief Draws a monochromatic bitmap stored in flash memory (such as ESPBOY_LOGO).
+         */
+        void drawBitmap(int32_t const x, int32_t const y, uint8_t const *bitmap, int32_t const w, int32_t const h, uint16_t const color);
+
+        /**
+         * @brief Draws an RGB565 image stored in flash memory.
+         */
+        void pushImage(int32_t const x, int32_t const y, int32_t const w, int32_t const h, uint16_t const *data);
+
+        /**
+         * @brief Draws an RGB565 image stored in flash memory, skipping its transparent pixels.
+         */
+        void pushImage(int32_t const x, int32_t const y, int32_t const w, int32_t const h, uint16_t const *data, uint16_t const transparent);
+
+        /**
+         * @brief Draws a compressed asset, which is decoded again for each strip it overlaps.
+         */
+        void drawAsset(Asset const &asset, int32_t const x, int32_t const y, uint16_t const color = 0xffff);
+
+        void setTextColor(uint16_t const color);
+        void setTextColor(uint16_t const fg, uint16_t const bg);
+        void setTextDatum(uint8_t const datum);
+        void drawString(char const *text, int32_t const x, int32_t const y);
+        void drawString(__FlashStringHelper const *text, int32_t const x, int32_t const y);
+
+        /**
+         * @brief Rasterizes the display list and streams it to the display.
+         */
+        void render();
+
+        /**
+         * @brief Waits for the end of the transfer started by render().
+         */
+        void wait();
+
+};
+
+/*
+ * ----------------------------------------------------------------------------
+ * ESPboy Library
+ * ----------------------------------------------------------------------------
+ * Copyright (c) 2021-2022 Stéphane Calderoni (https://github.com/m1cr0lab)
+ * 
+ * This program is free software: you can redistribute it and/or modify
+ * it under the terms of the GNU General Public License as published by
+ * the Free Software Foundation, either version 3 of the License, or
+ * (at your option) any later version.
+ * 
+ * This program is distributed in the hope that it will be useful,
+ * but WITHOUT ANY WARRANTY; without even the implied warranty of
+ * MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE. See the
+ * GNU General Public License for more details.
+ * 
+ * You should have received a copy of the GNU General Public License
+ * along with this program. If not, see <https://www.gnu.org/licenses/>.
+ * ----------------------------------------------------------------------------
+ */
\ No newline at end of file
@@ -0,0 +1,377 @@
+/**
+ * ----------------------------------------------------------------------------
+ * @file   TileMap.cpp
+ * @author Stéphane Calderoni (https://github.com/m1cr0lab)
+ * @brief  Tilemap and sprite engine with dirty tile tracking
+ * ----------------------------------------------------------------------------
+ */
+
+#include "TileMap.h"
+#include "Profiler.h"
+
+#include <new>
+
+TileMap::TileMap(hal::Display &tft)
+: _tft(&tft)
+, _buffer(nullptr)
+, _tiles(nullptr)
+, _cols(0)
+, _rows(0)
+, _background(0)
+, _view_x(0)
+, _view_y(0)
+, _line(0)
+, _hardware_scroll(false)
+, _scroll_pending(false)
+, _rendered_pixels(0)
+, _sprite_count(0)
+{}
+
+TileMap::~TileMap() { end(); }
+
+bool TileMap::begin(
+    TileSheet const &sheet,
+    uint8_t * const tiles,
+    uint16_t const cols,
+    uint16_t const rows,
+    uint16_t const background,
+    bool const hardware_scroll
+) {
+
+    end();
+
+    _buffer = new (std::nothrow) uint16_t[WIDTH << _CELL_SHIFT];
+    if (!_buffer) return false;
+
+    _sheet      = sheet;
+    _tiles      = tiles;
+    _cols       = cols;
+    _rows       = rows;
+    _background = background;
+    _view_x     = _view_y = 0;
+    _line       = 0;
+
+    _hardware_scroll = hardware_scroll && hal::scrollDisplay(*_tft, 0);
+    _scroll_pending  = false;
+
+    for (uint8_t i = 0; i < MAX_SPRITES; ++i) _sprites[i].used = false;
+    _sprite_count = 0;
+
+    invalidate();
+
+    return true;
+
+}
+
+void TileMap::end() {
+
+    if (!_buffer) return;
+
+    delete[] _buffer;
+    _buffer = nullptr;
+
+    if (_hardware_scroll) hal::scrollDisplay(*_tft, 0);
+
+}
+
+uint8_t TileMap::tile(uint16_t const col, uint16_t const row) const { return _tiles[row * _cols + col]; }
+
+void TileMap::setTile(uint16_t const col, uint16_t const row, uint8_t const tile) {
+
+    uint8_t &t = _tiles[row * _cols + col];
+    if (t == tile) return;
+
+    t = tile;
+    _mark(col * _sheet.size, row * _sheet.size, _sheet.size, _sheet.size);
+
+}
+
+int32_t TileMap::viewX()          const { return _view_x;          }
+int32_t TileMap::viewY()          const { return _view_y;          }
+bool    TileMap::hardwareScroll() const { return _hardware_scroll; }
+
+void TileMap::scrollTo(int32_t const x, int32_t const y) {
+
+    int32_t const dx = x - _view_x;
+    int32_t const dy = y - _view_y;
+    int32_t const y0 = _view_y;
+
+    if (!dx && !dy) return;
+
+    _view_x = x;
+    _view_y = y;
+
+    if (!_hardware_scroll) { invalidate(); return; }
+
+    // a map row is always drawn at the same display memory row
+    _line           = y & (HEIGHT - 1);
+    _scroll_pending = true;
+
+         if (dx || dy <= -HEIGHT || dy >= HEIGHT) invalidate();
+    else if (dy > 0) _mark(x, y0 + HEIGHT, WIDTH, dy);
+    else             _mark(x, y, WIDTH, -dy);
+
+}
+
+void TileMap::invalidate() {
+
+    for (uint8_t row = 0; row < _ROWS; ++row) _dirty[row] = 0xffff;
+
+}
+
+void TileMap::_mark(int32_t const x, int32_t const y, int32_t const w, int32_t const h) {
+
+    int32_t const x0 = x - _view_x;
+    int32_t const y0 = y > _view_y ? y : _view_y;
+    int32_t const y1 = y + h < _view_y + HEIGHT ? y + h : _view_y + HEIGHT;
+
+    if (y0 >= y1) return;
+
+    // the visible rows may wrap around the display memory
+    uint8_t const m = (y0 - _view_y + _line) & (HEIGHT - 1);
+    uint8_t const n = y1 - y0;
+    uint8_t const first = n < HEIGHT - m ? n : HEIGHT - m;
+
+    _markRows(x0, x0 + w, m, first);
+    if (n > first) _markRows(x0, x0 + w, 0, n - first);
+
+}
+
+void TileMap::_markRows(int32_t x0, int32_t x1, uint8_t const m, uint8_t const n) {
+
+    if (x0 < 0)     x0 = 0;
+    if (x1 > WIDTH) x1 = WIDTH;
+    if (x0 >= x1)   return;
+
+    uint8_t const c0 = x0 >> _CELL_SHIFT;
+    uint8_t const c1 = (x1 - 1) >> _CELL_SHIFT;
+    uint8_t const r1 = (m + n - 1) >> _CELL_SHIFT;
+
+    uint16_t const cols = (uint16_t)((0xffff << c0) & (0xffff >> (15 - c1)));
+
+    for (uint8_t row = m >> _CELL_SHIFT; row <= r1; ++row) _dirty[row] |= cols;
+
+}
+
+void TileMap::_markSprite(uint8_t const id) {
+
+    _Sprite const &s = _sprites[id];
+    if (s.visible) _mark(s.x, s.y, s.sheet.size, s.sheet.size);
+
+}
+
+void TileMap::_sort() {
+
+    _sprite_count = 0;
+
+    for (uint8_t id = 0; id < MAX_SPRITES; ++id) {
+
+        if (!_sprites[id].used) continue;
+
+        uint8_t i = _sprite_count++;
+        for (; i && _sprites[_order[i - 1]].z > _sprites[id].z; --i) _order[i] = _order[i - 1];
+        _order[i] = id;
+
+    }
+
+}
+
+int8_t TileMap::addSprite(TileSheet const &sheet, uint8_t const frame, int32_t const x, int32_t const y, int8_t const z) {
+
+    for (uint8_t id = 0; id < MAX_SPRITES; ++id) {
+
+        if (_sprites[id].used) continue;
+
+        _sprites[id] = { sheet, x, y, frame, z, true, true };
+        _sort();
+        _markSprite(id);
+
+        return id;
+
+    }
+
+    return -1;
+
+}
+
+bool TileMap::_used(uint8_t const id) const { return id < MAX_SPRITES && _sprites[id].used; }
+
+void TileMap::removeSprite(uint8_t const id) {
+
+    if (!_used(id)) return;
+
+    _markSprite(id);
+    _sprites[id].used = false;
+    _sort();
+
+}
+
+void TileMap::moveSprite(uint8_t const id, int32_t const x, int32_t const y) {
+
+    if (!_used(id)) return;
+
+    _Sprite &s = _sprites[id];
+    if (s.x == x && s.y == y) return;
+
+    _markSprite(id);
+    s.x = x;
+    s.y = y;
+    _markSprite(id);
+
+}
+
+void TileMap::setSpriteFrame(uint8_t const id, uint8_t const frame) {
+
+    if (!_used(id)) return;
+
+    if (_sprites[id].frame == frame) return;
+
+    _sprites[id].frame = frame;
+    _markSprite(id);
+
+}
+
+void TileMap::setSpriteZ(uint8_t const id, int8_t const z) {
+
+    if (!_used(id)) return;
+
+    if (_sprites[id].z == z) return;
+
+    _sprites[id].z = z;
+    _sort();
+    _markSprite(id);
+
+}
+
+void TileMap::showSprite(uint8_t const id, bool const visible) {
+
+    if (!_used(id)) return;
+
+    _Sprite &s = _sprites[id];
+    if (s.visible == visible) return;
+
+    _markSprite(id);
+    s.visible = visible;
+    _markSprite(id);
+
+}
+
+/**
+ * @brief Composes n consecutive cells of a row into the buffer.
+ */
+void TileMap::_compose(uint8_t const row, uint8_t const col, uint8_t const n) {
+
+    uint8_t  const w      = n << _CELL_SHIFT;
+    int32_t  const wx     = _view_x + (col << _CELL_SHIFT);
+    uint8_t  const size   = _sheet.size;
+    uint8_t  const shift  = size == 16 ? 4 : 3;
+    uint16_t const bg     = hal::displayOrder(_background);
+
+    for (uint8_t j = 0; j < _CELL_SIZE; ++j) {
+
+        uint16_t * const p = _buffer + j * w;
+        uint8_t  const   m = (row << _CELL_SHIFT) + j;
+        int32_t  const  wy = _view_y + ((m - _line) & (HEIGHT - 1));
+        int32_t  const  ty = wy >> shift;
+
+        // background tiles
+        for (uint8_t i = 0; i < w;) {
+
+            int32_t const x    = wx + i;
+            int32_t const tx   = x >> shift;
+            uint8_t const ox   = x & (size - 1);
+            uint8_t const span = size - ox < w - i ? size - ox : w - i;
+
+            if (x < 0 || wy < 0 || tx >= _cols || ty >= _rows) {
+                for (uint8_t k = 0; k < span; ++k) p[i + k] = bg;
+            } else {
+                uint8_t const t = _tiles[ty * _cols + tx];
+                memcpy_P(p + i, _sheet.pixels + ((t * size + (wy & (size - 1))) << shift) + ox, span << 1);
+            }
+
+            i += span;
+
+        }
+
+        // sprites
+        for (uint8_t k = 0; k < _sprite_count; ++k) {
+
+            _Sprite const &s = _sprites[_order[k]];
+            int32_t const  sz = s.sheet.size;
+
+            if (!s.visible || wy < s.y || wy >= s.y + sz || s.x >= wx + w || s.x + sz <= wx) continue;
+
+            int32_t const i0 = s.x > wx ? s.x - wx : 0;
+            int32_t const i1 = s.x + sz < wx + w ? s.x + sz - wx : w;
+
+            uint16_t const *src = s.sheet.pixels + (s.frame * sz + wy - s.y) * sz + (wx + i0 - s.x);
+
+            for (int32_t i = i0; i < i1; ++i) {
+                uint16_t const c = pgm_read_word(src++);
+                if (c != s.sheet.transparent) p[i] = c;
+            }
+
+        }
+
+    }
+
+    _tft->pushImage(col << _CELL_SHIFT, row << _CELL_SHIFT, w, _CELL_SIZE, _buffer);
+    _rendered_pixels += w << _CELL_SHIFT;
+
+}
+
+void TileMap::render() {
+
+    Profiler::Scope scope(Profiler::FLUSH);
+
+    if (_scroll_pending) {
+        hal::scrollDisplay(*_tft, _line);
+        _scroll_pending = false;
+    }
+
+    _rendered_pixels = 0;
+
+    _tft->startWrite();
+
+    for (uint8_t row = 0; row < _ROWS; ++row) {
+
+        uint16_t dirty = _dirty[row];
+        _dirty[row] = 0;
+
+        uint8_t col = 0;
+        while (dirty) {
+            while (!(dirty & 1)) { dirty >>= 1; col++; }
+            uint8_t n = 0;
+            while (dirty & 1) { dirty >>= 1; n++; }
+            _compose(row, col, n);
+            col += n;
+        }
+
+    }
+
+    _tft->endWrite();
+
+}
+
+uint32_t TileMap::renderedPixels() const { return _rendered_pixels; }
+
+/*
+ * ----------------------------------------------------------------------------
+ * ESPboy Library
+ * ----------------------------------------------------------------------------
+ * Copyright (c) 2021-2022 Stéphane Calderoni (https://github.com/m1cr0lab)
+ * 
+ * This program is free software: you can redistribute it and/or modify
+ * it under the terms of the GNU General Public License as published by
+ * the Free Software Foundation, either version 3 of the License, or
+ * (at your option) any later version.
+ * 
+ * This program is distributed in the hope that it will be useful,
+ * but WITHOUT ANY WARRANTY; without even the implied warranty of
+ * MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE. See the
+ * GNU General Public License for more details.
+ * 
+ * You should have received a copy of the GNU General Public License
+ * along with this program. If not, see <https://www.gnu.org/licenses/>.
+ * ----------------------------------------------------------------------------
+ */
\ No newline at end of file
@@ -0,0 +1,220 @@
+/**
+ * ----------------------------------------------------------------------------
+ * @file   TileMap.h
+ * @author Stéphane Calderoni (https://github.com/m1cr0lab)
+ * @brief  Tilemap and sprite engine with dirty tile tracking
+ * ----------------------------------------------------------------------------
+ */
+
+#pragma once
+
+#include "HAL.h"
+
+/**
+ * @brief A sheet of square tiles (or sprite frames) stored in flash memory.
+ * 
+ * @details The tiles are stored one after the other, each of them as a
+ *          colormap of size x size pixels laid out like the colormaps given
+ *          to pushImage().
+ */
+struct TileSheet {
+
+    uint16_t const *pixels;
+    uint8_t         size;        // 8 or 16
+    uint16_t        transparent; // sprite pixels left out, in the layout of the pixels
+
+    constexpr TileSheet(uint16_t const *pixels, uint8_t const size = 8, uint16_t const transparent = 0xf81f)
+    : pixels(pixels), size(size), transparent(transparent) {}
+
+    constexpr TileSheet() : pixels(nullptr), size(8), transparent(0xf81f) {}
+
+};
+
+/**
+ * @brief This class draws a scrolling tilemap and its sprites straight to the
+ *        display, without any framebuffer.
+ * 
+ * @details The screen is divided into 8x8 pixel cells. Changing a tile, or
+ *          moving, animating or hiding a sprite, marks the cells it covers as
+ *          dirty, and render() only recomposes those cells (background tiles,
+ *          then the sprites in ascending z-order with their transparent pixels
+ *          left out) into a buffer of a single row of cells, which is pushed
+ *          to the display.
+ * 
+ *          Tiles and sprites are positioned in map coordinates, and the view
+ *          is moved with scrollTo(). Vertical scrolling relies on the scroll
+ *          registers of the display controller: the rows already drawn are
+ *          kept and only the newly exposed ones are rendered. Horizontal
+ *          scrolling, or vertical scrolling on a rotated display, redraws
+ *          the whole screen.
+ * 
+ *          The engine takes 2 KB of heap, and the map is a caller-owned
+ *          array of tile indexes, row after row.
+ */
+class TileMap {
+
+    public:
+
+        static uint8_t constexpr WIDTH       = 128;
+        static uint8_t constexpr HEIGHT      = 128;
+        static uint8_t constexpr MAX_SPRITES = 16;
+
+    private:
+
+        static uint8_t constexpr _CELL_SHIFT = 3;
+        static uint8_t constexpr _CELL_SIZE  = 1 << _CELL_SHIFT;
+        static uint8_t constexpr _COLS       = WIDTH  >> _CELL_SHIFT;
+        static uint8_t constexpr _ROWS       = HEIGHT >> _CELL_SHIFT;
+
+        struct _Sprite {
+
+            TileSheet sheet;
+            int32_t   x, y;
+            uint8_t   frame;
+            int8_t    z;
+            bool      visible;
+            bool      used;
+
+        };
+
+        hal::Display *_tft;
+        uint16_t     *_buffer;      // one row of cells
+
+        TileSheet _sheet;
+        uint8_t  *_tiles;
+        uint16_t  _cols;
+        uint16_t  _rows;
+        uint16_t  _background;
+
+        int32_t  _view_x;
+        int32_t  _view_y;
+        uint8_t  _line;             // display memory row shown at the top of the screen
+        bool     _hardware_scroll;
+        bool     _scroll_pending;
+
+        uint16_t _dirty[_ROWS];     // cells to be rendered (1 bit per column), in display memory rows
+        uint32_t _rendered_pixels;
+
+        _Sprite  _sprites[MAX_SPRITES];
+        uint8_t  _order[MAX_SPRITES]; // sprites sorted by z
+        uint8_t  _sprite_count;
+
+        void _mark(int32_t const x, int32_t const y, int32_t const w, int32_t const h);
+        void _markRows(int32_t x0, int32_t x1, uint8_t const m, uint8_t const n);
+        void _markSprite(uint8_t const id);
+        bool _used(uint8_t const id) const;
+        void _sort();
+        void _compose(uint8_t const row, uint8_t const col, uint8_t const n);
+
+    public:
+
+        /**
+         * @param tft Display controller the map is drawn to (typically espboy.tft).
+         */
+        TileMap(hal::Display &tft);
+        ~TileMap();
+
+        /**
+         * @brief Sets the map up and allocates the cell buffer.
+         * 
+         * @param sheet           Tiles of the map.
+         * @param tiles           Tile indexes, row after row (cols x rows bytes).
+         * @param cols            Width of the map in tiles.
+         * @param rows            Height of the map in tiles.
+         * @param background      RGB565 color drawn outside the map.
+         * @param hardware_scroll Whether the scroll registers of the display may be used.
+         * 
+         * @return true if the allocation has succeeded.
+         */
+        bool begin(
+            TileSheet const &sheet,
+            uint8_t * const tiles,
+            uint16_t const cols,
+            uint16_t const rows,
+            uint16_t const background = 0,
+            bool const hardware_scroll = true
+        );
+
+        /**
+         * @brief Releases the cell buffer and restores the display scrolling.
+         */
+        void end();
+
+        uint8_t tile(uint16_t const col, uint16_t const row) const;
+        void    setTile(uint16_t const col, uint16_t const row, uint8_t const tile);
+
+        /**
+         * @brief Moves the view so that its top left corner shows the map at (x, y).
+         */
+        void scrollTo(int32_t const x, int32_t const y);
+
+        int32_t viewX() const;
+        int32_t viewY() const;
+
+        /**
+         * @brief Whether vertical scrolling keeps the rows already drawn.
+         */
+        bool hardwareScroll() const;
+
+        /**
+         * @brief Adds a sprite.
+         * 
+         * @param sheet Frames of the sprite.
+         * @param frame Index of the frame shown.
+         * @param x     Abscissa in the map.
+         * @param y     Ordinate in the map.
+         * @param z     Sprites with greater z are drawn on top of the others.
+         * 
+         * @return The sprite identifier, or -1 if there are already MAX_SPRITES sprites.
+         */
+        int8_t addSprite(TileSheet const &sheet, uint8_t const frame, int32_t const x, int32_t const y, int8_t const z = 0);
+
+        /**
+         * @brief Sprite operations, which ignore the identifiers of the sprites
+         *        that don't exist (such as the -1 of a failed addSprite()).
+         */
+        void removeSprite(uint8_t const id);
+        void moveSprite(uint8_t const id, int32_t const x, int32_t const y);
+        void setSpriteFrame(uint8_t const id, uint8_t const frame);
+        void setSpriteZ(uint8_t const id, int8_t const z);
+        void showSprite(uint8_t const id, bool const visible = true);
+
+        /**
+         * @brief Forces the next render() to redraw the whole screen.
+         */
+        void invalidate();
+
+        /**
+         * @brief Draws the dirty cells.
+         */
+        void render();
+
+        /**
+         * @brief Number of pixels pushed to the display by the last render().
+         * 
+         * @details The SPI traffic amounts to 2 bytes per pixel.
+         */
+        uint32_t renderedPixels() const;
+
+};
+
+/*
+ * ----------------------------------------------------------------------------
+ * ESPboy Library
+ * ----------------------------------------------------------------------------
+ * Copyright (c) 2021-2022 Stéphane Calderoni (https://github.com/m1cr0lab)
+ * 
+ * This program is free software: you can redistribute it and/or modify
+ * it under the terms of the GNU General Public License as published by
+ * the Free Software Foundation, either version 3 of the License, or
+ * (at your option) any later version.
+ * 
+ * This program is distributed in the hope that it will be useful,
+ * but WITHOUT ANY WARRANTY; without even the implied warranty of
+ * MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE. See the
+ * GNU General Public License for more details.
+ * 
+ * You should have received a copy of the GNU General Public License
+ * along with this program. If not, see <https://www.gnu.org/licenses/>.
+ * ----------------------------------------------------------------------------
+ */
\ No newline at end of file